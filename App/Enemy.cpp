@@ -1,4 +1,5 @@
 #include "enemy.hpp"
+#include "grid_units.hpp"
 #include <cmath>
 #include <limits>
 
@@ -6,14 +7,16 @@
 
 
 Enemy::Enemy(const std::vector<Node*>& path, float speed, int health)
-    : path(path), baseSpeed(speed), health(health), maxHealth(health),
+    : id(-1), path(path), baseSpeed(speed), health(health), maxHealth(health),
       currentNodeIndex(0), reachedGoal(false), 
       currentDirection(Direction::East), currentFrame(0),
       animationTimer(0.f), frameTime(0.15f)
 {
     if (!path.empty()) {
-        position = sf::Vector2f(path[0]->x * 48.f + 24.f, path[0]->y * 48.f + 24.f);
+        position = cellToWorld(path[0]->x, path[0]->y);
     }
+    previousPosition = position;
+    appendDistances(0);
 
     shape.setRadius(12.f);
     shape.setFillColor(sf::Color::Red);
@@ -58,41 +61,71 @@ void Enemy::updateAnimation(float deltaTime) {
 }
 
 void Enemy::update(float deltaTime) {
+    previousPosition = position;
     if (reachedGoal || path.empty()) return;
 
-    Node* target = path[currentNodeIndex];
-    sf::Vector2f targetPos(target->x * 48.f + 24.f, target->y * 48.f + 24.f);
+    // Walk the route, carrying whatever is left of the tick past each node
+    float timeLeft = deltaTime;
+    while (timeLeft > 0.f) {
+        if (currentNodeIndex >= static_cast<int>(path.size())) {
+            if (!hasPendingWaypoints()) reachedGoal = true;
+            break;  // Otherwise wait here until the next segment is refined
+        }
 
-    sf::Vector2f dir = targetPos - position;
-    float len = std::sqrt(dir.x * dir.x + dir.y * dir.y);
+        Node* target = path[currentNodeIndex];
+        float remaining = pathDistances[currentNodeIndex] - distanceTravelled;
+        float speed = getCurrentSpeed(target);
+        if (speed * timeLeft < remaining) {
+            distanceTravelled += speed * timeLeft;
+            break;
+        }
 
-    if (len < 1.f) {
+        distanceTravelled = pathDistances[currentNodeIndex];
+        if (remaining > 0.f) timeLeft -= remaining / speed;
+        position = cellToWorld(target->x, target->y);
         currentNodeIndex++;
-        if (currentNodeIndex >= static_cast<int>(path.size())) {
-            reachedGoal = true;
-            return;
-        }
-        return;
+        beginSegment();
     }
+    updatePosition();
 
-    dir /= len;
-    
-    // Update direction based on movement
-    updateDirection(dir);
-    
-    float effectiveSpeed = getCurrentSpeed(target);
-    sf::Vector2f movement = dir * effectiveSpeed * deltaTime;
-    position += movement;
-    shape.setPosition(position);
-    
     // Update animation
     updateAnimation(deltaTime);
-    
+}
+
+void Enemy::beginSegment() {
+    if (currentNodeIndex >= static_cast<int>(path.size())) return;
+
+    float length = pathDistances[currentNodeIndex] - distanceTravelled;
+    if (length <= 0.f) return;  // Already there; the next update moves on
+
+    Node* target = path[currentNodeIndex];
+    segmentDirection = (cellToWorld(target->x, target->y) - position) / length;
+    updateDirection(segmentDirection);
+}
+
+void Enemy::updatePosition() {
+    if (currentNodeIndex < static_cast<int>(path.size())) {
+        Node* target = path[currentNodeIndex];
+        position = cellToWorld(target->x, target->y) - segmentDirection * (pathDistances[currentNodeIndex] - distanceTravelled);
+    }
+    shape.setPosition(position);
     if (sprite) {
         sprite->setPosition(position);
     }
 }
 
+void Enemy::appendDistances(std::size_t from) {
+    pathDistances.resize(path.size());
+    for (std::size_t i = from; i < path.size(); i++) {
+        if (i == 0) {
+            pathDistances[i] = distanceTravelled;
+            continue;
+        }
+        sf::Vector2f step = cellToWorld(path[i]->x, path[i]->y) - cellToWorld(path[i - 1]->x, path[i - 1]->y);
+        pathDistances[i] = pathDistances[i - 1] + std::sqrt(step.x * step.x + step.y * step.y);
+    }
+}
+
 void Enemy::setDirectionalTextures(Direction dir, sf::Texture& frame1, sf::Texture& frame2) {
     directionTextures[dir] = {&frame1, &frame2};
     
@@ -104,8 +137,8 @@ void Enemy::setDirectionalTextures(Direction dir, sf::Texture& frame1, sf::Textu
         sprite->setOrigin({texSize.x / 2.f, texSize.y / 2.f});
         sprite->setPosition(position);
         
-        float scaleX = 48.f / texSize.x;
-        float scaleY = 48.f / texSize.y;
+        float scaleX = CELL_SIZE / texSize.x;
+        float scaleY = CELL_SIZE / texSize.y;
         sprite->setScale({scaleX, scaleY});
     }
     
@@ -115,8 +148,8 @@ void Enemy::setDirectionalTextures(Direction dir, sf::Texture& frame1, sf::Textu
         
         // Flip sprite horizontally if facing West
         sf::Vector2u texSize = frame1.getSize();
-        float scaleX = 48.f / texSize.x;
-        float scaleY = 48.f / texSize.y;
+        float scaleX = CELL_SIZE / texSize.x;
+        float scaleY = CELL_SIZE / texSize.y;
         if (dir == Direction::West) {
             sprite->setScale({-scaleX, scaleY});  // Negative X scale flips horizontally
         } else {
@@ -133,8 +166,8 @@ void Enemy::refreshSpriteTexture() {
         // Apply horizontal flip for West direction
         if (!directionTextures[currentDirection].empty()) {
             sf::Vector2u texSize = directionTextures[currentDirection][0]->getSize();
-            float scaleX = 48.f / texSize.x;
-            float scaleY = 48.f / texSize.y;
+            float scaleX = CELL_SIZE / texSize.x;
+            float scaleY = CELL_SIZE / texSize.y;
             
             if (currentDirection == Direction::West) {
                 sprite->setScale({-scaleX, scaleY});  // Flip horizontally for West
@@ -151,16 +184,16 @@ float Enemy::getCurrentSpeed(Node* node) const {
     return baseSpeed / std::max(1.0f, node->slowMultiplier);
 }
 
-void Enemy::draw(sf::RenderWindow& window) {
+void Enemy::draw(RenderList& out) {
     if (sprite) {
-        window.draw(*sprite);
+        out.add(*sprite, getMotion());
     } else {
-        window.draw(shape);
+        out.add(shape, getMotion());
     }
-    drawHealthBar(window);
+    drawHealthBar(out);
 }
 
-void Enemy::drawHealthBar(sf::RenderWindow& window) const {
+void Enemy::drawHealthBar(RenderList& out) const {
     // Health bar dimensions
     float barWidth = 30.f;
     float barHeight = 4.f;
@@ -170,7 +203,7 @@ void Enemy::drawHealthBar(sf::RenderWindow& window) const {
     sf::RectangleShape bgBar({barWidth, barHeight});
     bgBar.setPosition({position.x - barWidth / 2.f, position.y + barOffsetY});
     bgBar.setFillColor(sf::Color(60, 60, 60));  // Dark gray background
-    window.draw(bgBar);
+    out.add(bgBar, getMotion());
     
     // Foreground (green - current health)
     float healthPercent = static_cast<float>(health) / static_cast<float>(maxHealth);
@@ -186,7 +219,7 @@ void Enemy::drawHealthBar(sf::RenderWindow& window) const {
         healthBar.setFillColor(sf::Color::Red);
     }
     
-    window.draw(healthBar);
+    out.add(healthBar, getMotion());
 }
 
 void Enemy::takeDamage(int dmg) {
@@ -196,10 +229,13 @@ void Enemy::takeDamage(int dmg) {
 
 void Enemy::setPath(const std::vector<Node*>& newPath) {
     path = newPath;
+    waypoints.clear();
+    nextWaypoint = 0;
     reachedGoal = false;
 
     if (path.empty()) {
         currentNodeIndex = 0;
+        pathDistances.clear();
         return;
     }
 
@@ -208,30 +244,45 @@ void Enemy::setPath(const std::vector<Node*>& newPath) {
     float minDist = std::numeric_limits<float>::max();
 
     for (int i = 0; i < static_cast<int>(path.size()); ++i) {
-        sf::Vector2f nodePos(path[i]->x * 48.f + 24.f, path[i]->y * 48.f + 24.f);
-        sf::Vector2f diff = position - nodePos;
-        float dist = std::sqrt(diff.x * diff.x + diff.y * diff.y);
+        sf::Vector2f diff = position - cellToWorld(path[i]->x, path[i]->y);
+        float dist = diff.x * diff.x + diff.y * diff.y;
         if (dist < minDist) {
             minDist = dist;
             closestIdx = i;
         }
     }
 
+    // Head straight for it, then follow the path; nodes before it are never walked
     currentNodeIndex = closestIdx;
-    
-    // Update direction based on new path to ensure sprite shows correct direction
-    if (currentNodeIndex < static_cast<int>(path.size()) - 1) {
-        Node* nextNode = path[currentNodeIndex + 1];
-        sf::Vector2f nextPos(nextNode->x * 48.f + 24.f, nextNode->y * 48.f + 24.f);
-        sf::Vector2f direction = nextPos - position;
-        
-        // Normalize and update direction
-        float len = std::sqrt(direction.x * direction.x + direction.y * direction.y);
-        if (len > 0.01f) {
-            direction /= len;
-            updateDirection(direction);  // This triggers refreshSpriteTexture if direction changes
-        }
+    pathDistances.assign(path.size(), distanceTravelled);
+    pathDistances[closestIdx] = distanceTravelled + std::sqrt(minDist);
+    appendDistances(closestIdx + 1);
+    beginSegment();
+}
+
+void Enemy::setWaypoints(const std::vector<Node*>& route) {
+    waypoints = route;
+    nextWaypoint = 0;
+}
+
+void Enemy::extendPath(const std::vector<Node*>& cells) {
+    bool waiting = currentNodeIndex >= static_cast<int>(path.size());
+    std::size_t from = path.size();
+    path.insert(path.end(), cells.begin(), cells.end());
+    appendDistances(from);
+    if (waiting) beginSegment();  // Was stopped at the old end
+}
+
+float Enemy::getRemainingDistance() const {
+    float remaining = pathDistances.empty() ? 0.f : pathDistances.back() - distanceTravelled;
+
+    // The unrefined part of the route, waypoint to waypoint
+    const Node* from = getPathEnd();
+    for (std::size_t i = nextWaypoint; i < waypoints.size(); i++) {
+        if (from) remaining += (std::abs(waypoints[i]->x - from->x) + std::abs(waypoints[i]->y - from->y)) * CELL_SIZE;
+        from = waypoints[i];
     }
+    return remaining;
 }
 
 bool Enemy::isDead() const { return health <= 0; }
@@ -260,14 +311,14 @@ ShieldEnemy::ShieldEnemy(const std::vector<Node*>& path)
     shape.setFillColor(sf::Color(0, 100, 255));
 }
 
-void ShieldEnemy::draw(sf::RenderWindow& window) {
+void ShieldEnemy::draw(RenderList& out) {
     if (sprite) {
-        window.draw(*sprite);
+        out.add(*sprite, getMotion());
     } else {
-        window.draw(shape);
+        out.add(shape, getMotion());
     }
     
-    drawHealthBar(window);
+    drawHealthBar(out);
     
     if (maxShield > 0) {
         float barWidth = 30.f;
@@ -277,13 +328,13 @@ void ShieldEnemy::draw(sf::RenderWindow& window) {
         sf::RectangleShape bgBar({barWidth, barHeight});
         bgBar.setPosition({position.x - barWidth / 2.f, position.y + shieldOffsetY});
         bgBar.setFillColor(sf::Color(40, 40, 40));
-        window.draw(bgBar);
+        out.add(bgBar, getMotion());
         
         float shieldPercent = static_cast<float>(shield) / static_cast<float>(maxShield);
         sf::RectangleShape shieldBar({barWidth * shieldPercent, barHeight});
         shieldBar.setPosition({position.x - barWidth / 2.f, position.y + shieldOffsetY});
         shieldBar.setFillColor(sf::Color::Cyan);
-        window.draw(shieldBar);
+        out.add(shieldBar, getMotion());
     }
 }
 
@@ -291,7 +342,9 @@ void ShieldEnemy::takeDamage(int dmg) {
     if (shield > 0) {
         shield -= dmg;
         if (shield < 0) {
+            // Damage beyond the shield carries over into health
             health += shield;
+            if (health < 0) health = 0;
             shield = 0;
         }
     } else {
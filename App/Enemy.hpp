@@ -6,6 +6,7 @@
 #include <optional>
 #include <map>
 #include "node.hpp"
+#include "render_list.hpp"
 
 enum class Direction {
     North,
@@ -15,14 +16,28 @@ enum class Direction {
 };
 class Enemy {
 protected:
+    int id;             // Unique per match, assigned in spawn order
     sf::Vector2f position;
+    sf::Vector2f previousPosition;  // Position at the start of the last tick, for interpolation
     float baseSpeed;
     int health;
     int maxHealth;  // Add max health to calculate health bar percentage
     bool reachedGoal;
 
+    // Movement is parametric: the enemy only tracks how far it has walked,
+    // and its position is found from the segment that distance falls in.
+    // pathDistances[i] is the distance travelled at which path[i] is
+    // reached, worked out once when the path is set.
     std::vector<Node*> path;
-    int currentNodeIndex;
+    std::vector<float> pathDistances;
+    int currentNodeIndex;               // Node being walked towards
+    float distanceTravelled = 0.f;      // Since spawning
+    sf::Vector2f segmentDirection;      // Unit vector towards path[currentNodeIndex]
+
+    // Coarse route past the end of `path` on large maps, refined into cells
+    // a cluster at a time as the enemy gets close (see HierarchicalPathfinder)
+    std::vector<Node*> waypoints;
+    std::size_t nextWaypoint = 0;
 
     sf::CircleShape shape;
 
@@ -34,28 +49,58 @@ protected:
     float frameTime;  
 
     // Health bar rendering
-    void drawHealthBar(sf::RenderWindow& window) const;
+    void drawHealthBar(RenderList& out) const;
     void updateDirection(const sf::Vector2f& movement);
     void updateAnimation(float deltaTime);
+    void beginSegment();     // Aims at path[currentNodeIndex] from the current position
+    void updatePosition();   // Position from distanceTravelled
+    void appendDistances(std::size_t from);
 
 public:
     Enemy(const std::vector<Node*>& path, float speed = 100.f, int health = 100);
     virtual ~Enemy() = default;
 
     virtual void update(float deltaTime);
-    virtual void draw(sf::RenderWindow& window);
+    virtual void draw(RenderList& out);
     virtual void takeDamage(int dmg);
     
     void setDirectionalTextures(Direction dir, sf::Texture& frame1, sf::Texture& frame2);
     void refreshSpriteTexture();  // Refresh sprite to current direction
 
-    void setPath(const std::vector<Node*>& newPath);
+    void setPath(const std::vector<Node*>& newPath);  // Also drops any pending waypoints
+    void setWaypoints(const std::vector<Node*>& route);
+    void extendPath(const std::vector<Node*>& cells);  // Appends cells without moving the enemy along
+    bool hasPendingWaypoints() const { return nextWaypoint < waypoints.size(); }
+    Node* takeWaypoint() { return waypoints[nextWaypoint++]; }
+    Node* getPathEnd() const { return path.empty() ? nullptr : path.back(); }
+    int getRemainingNodes() const { return static_cast<int>(path.size()) - currentNodeIndex; }
+
+    // Progress: distance walked so far, and distance still to go to the goal
+    // (unrefined waypoints are counted cell by cell without detours)
+    float getDistanceTravelled() const { return distanceTravelled; }
+    float getRemainingDistance() const;
+
+    // True if `test` holds for any cell still ahead: the rest of the path
+    // (from the cell being walked to), then any unrefined waypoints
+    template <typename Test>
+    bool anyNodeAhead(Test&& test) const {
+        for (std::size_t i = currentNodeIndex; i < path.size(); i++) {
+            if (test(path[i])) return true;
+        }
+        for (std::size_t i = nextWaypoint; i < waypoints.size(); i++) {
+            if (test(waypoints[i])) return true;
+        }
+        return false;
+    }
 
     bool isDead() const;
     bool hasReachedGoal() const;
 
     const sf::Vector2f& getPosition() const;
+    sf::Vector2f getMotion() const { return position - previousPosition; }
     int getHealth() const { return health; }
+    int getId() const { return id; }
+    void setId(int newId) { id = newId; }
 
     virtual float getCurrentSpeed(Node* node) const;
 };
@@ -85,7 +130,7 @@ class ShieldEnemy : public Enemy {
 public:
     ShieldEnemy(const std::vector<Node*>& path);
     void takeDamage(int dmg) override;
-    void draw(sf::RenderWindow& window) override;  // Override to draw shield bar
+    void draw(RenderList& out) override;  // Override to draw shield bar
     int getShield() const { return shield; }
 };
 
@@ -1,42 +1,209 @@
 #include "a_star_path_finder.hpp"
 #include <cmath>
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <queue>
+#include "profiler.hpp"
+#include "memory_tracker.hpp"
+#include "frame_arena.hpp"
 
-AStarPathfinder::AStarPathfinder(Grid* grid) : grid(grid) {}
+namespace {
+    // Shared by every pathfinder, so two of them on one grid never mistake
+    // each other's node data for their own
+    std::atomic<unsigned int> nextSearchId{1};
+}
+
+AStarPathfinder::AStarPathfinder(Grid* grid, SearchMode mode, OpenList openList)
+    : grid(grid), mode(mode), openList(openList) {}
+
+void AStarPathfinder::beginSearch() {
+    searchId = nextSearchId.fetch_add(1);
+    openSet.clear();
+    openBuckets.clear();
+    expandedNodes = 0;
+}
+
+void AStarPathfinder::pushOpen(Node* node) {
+    if (openList == OpenList::Buckets) openBuckets.push(node);
+    else openSet.push(node);
+}
+
+Node* AStarPathfinder::popOpen() {
+    return openList == OpenList::Buckets ? openBuckets.pop().node : openSet.pop();
+}
+
+bool AStarPathfinder::openEmpty() const {
+    return openList == OpenList::Buckets ? openBuckets.empty() : openSet.empty();
+}
+
+void AStarPathfinder::touch(Node* node) {
+    if (node->searchId != searchId) {
+        node->resetCosts();
+        node->searchId = searchId;
+    }
+}
 
 float AStarPathfinder::calculateHCost(Node* a, Node* b) {
+    if (useGoalDistances) {
+        return goalDistances[a->y * grid->getWidth() + a->x];
+    }
+
     // Manhattan Distance heuristic
     return std::abs(a->x - b->x) + std::abs(a->y - b->y);
 }
 
+// === Goal distance table ===
+
+void AStarPathfinder::refreshGoalDistances() {
+    sf::Vector2i goal = grid->getEnd();
+    std::size_t changes = grid->getCostChangeCount();
+    if (goal == goalDistanceCell && goalDistanceLayout == grid->getLayoutVersion() && goalDistanceChanges == changes) {
+        return;
+    }
+
+    ScopedTimer timer("GoalDistances");
+    int width = grid->getWidth();
+    goalDistances.assign(static_cast<std::size_t>(width) * grid->getHeight(), INFINITY);
+    goalDistanceCell = goal;
+    goalDistanceLayout = grid->getLayoutVersion();
+    goalDistanceChanges = changes;
+
+    Node* end = grid->getNode(goal.x, goal.y);
+    if (!end) return;
+
+    // Backwards from the goal: stepping from `current` back to a neighbour
+    // costs what entering `current` costs going forwards
+    using Entry = std::pair<float, Node*>;
+    ArenaScope scratch;
+    std::priority_queue<Entry, std::pmr::vector<Entry>, std::greater<Entry>> open(
+        std::greater<Entry>(), std::pmr::vector<Entry>(scratch.resource()));
+    std::pmr::vector<Node*> neighbors(scratch.resource());
+    bool buckets = (openList == OpenList::Buckets);
+    openBuckets.clear();
+
+    auto relax = [&](Node* current, float distance) {
+        float stepCost = current->getMovementCost();
+        grid->getNeighbors(current, neighbors);
+        for (Node* neighbor : neighbors) {
+            if (!neighbor->walkable) continue;
+
+            float& best = goalDistances[neighbor->y * width + neighbor->x];
+            if (distance + stepCost < best) {
+                best = distance + stepCost;
+                if (buckets) openBuckets.push(neighbor, best);
+                else open.push({best, neighbor});
+            }
+        }
+    };
+
+    goalDistances[goal.y * width + goal.x] = 0.f;
+    if (buckets) {
+        openBuckets.push(end, 0.f);
+        while (!openBuckets.empty()) {
+            BucketQueue::Entry top = openBuckets.pop();
+            if (top.priority > goalDistances[top.node->y * width + top.node->x]) continue;  // Stale entry
+            relax(top.node, top.priority);
+        }
+        return;
+    }
+
+    open.push({0.f, end});
+    while (!open.empty()) {
+        auto [distance, current] = open.top();
+        open.pop();
+        if (distance > goalDistances[current->y * width + current->x]) continue;  // Stale entry
+        relax(current, distance);
+    }
+}
+
+float AStarPathfinder::getGoalDistance(int x, int y) {
+    refreshGoalDistances();
+    if (x < 0 || y < 0 || x >= grid->getWidth() || y >= grid->getHeight()) return INFINITY;
+    return goalDistances[y * grid->getWidth() + x];
+}
+
+// === Search ===
+
 std::vector<Node*> AStarPathfinder::findPath(Node* start, Node* end) {
-    std::vector<Node*> path;
+    ArenaScope scratch;
+    std::pmr::vector<Node*> path(scratch.resource());
+    findPath(start, end, path);
+    return std::vector<Node*>(path.begin(), path.end());
+}
+
+bool AStarPathfinder::findPath(Node* start, Node* end, std::pmr::vector<Node*>& path) {
+    ScopedTimer timer("Pathfinding");
+    MemoryScope memory(MemoryTag::Pathfinding);
+    path.clear();
     // Early sanity checks before touching grid state
-    if (!start || !end) return {};
-    if (start == end) return {start};
+    if (!start || !end) return false;
+    if (start == end) {
+        path.push_back(start);
+        return true;
+    }
 
-    grid->resetCosts();
-    openSet.clear();
-    closedSet.clear();
+    if (!pathCacheEnabled) return search(start, end, path);
+
+    std::uint64_t gridHash = grid->getTopologyHash();
+    if (const std::vector<Node*>* cached = pathCache.find(start, end, grid->getLayoutVersion(), gridHash)) {
+        expandedNodes = 0;
+        path.assign(cached->begin(), cached->end());
+        return !path.empty();
+    }
+
+    bool found = search(start, end, path);
+    pathCache.store(start, end, gridHash, path);
+    return found;
+}
+
+bool AStarPathfinder::search(Node* start, Node* end, std::pmr::vector<Node*>& path) {
+
+    // Queries to the goal use the exact distance table as their heuristic,
+    // which also answers "is there a path at all" without searching
+    useGoalDistances = (end->x == grid->getEnd().x && end->y == grid->getEnd().y);
+    if (useGoalDistances) {
+        refreshGoalDistances();
+        if (goalDistances[start->y * grid->getWidth() + start->x] == INFINITY) {
+            expandedNodes = 0;
+            return false;
+        }
+    }
+
+    if (mode == SearchMode::JumpPoint) {
+        return findJumpPointPath(start, end, path);
+    }
 
+    beginSearch();
+
+    // Per-search scratch comes from the frame arena instead of the heap
+    FrameArena& arena = FrameArena::local();
+    std::pmr::vector<Node*> neighbors(&arena);
+    neighbors.reserve(4);
+
+    touch(start);
     start->gCost = 0;
     start->hCost = calculateHCost(start, end);
-    openSet.push(start);
+    pushOpen(start);
 
-    while (!openSet.empty()) {
-        Node* current = openSet.pop();
+    while (!openEmpty()) {
+        Node* current = popOpen();
+        if (current->closed) continue;  // Older entry for a node reached again more cheaply
+        expandedNodes++;
         if (current == end) {
             reconstructPath(start, end, path);
-            return path;
+            return true;
         }
 
-        closedSet.insert(current);
+        current->closed = true;
 
         // Check all neighboring cells 
-        for (Node* neighbor : grid->getNeighbors(current)) {
+        grid->getNeighbors(current, neighbors);
+        for (Node* neighbor : neighbors) {
             // Skip if neighbor is blocked or already visited
-            if (!neighbor->walkable || closedSet.count(neighbor)) 
-                continue;
+            if (!neighbor->walkable) continue;
+            touch(neighbor);
+            if (neighbor->closed) continue;
 
             // Calculate cost to reach this neighbor from current node
             float moveCost = neighbor->getMovementCost();  // Includes frost effect (if any)
@@ -51,21 +218,233 @@ std::vector<Node*> AStarPathfinder::findPath(Node* start, Node* end) {
                 neighbor->parent = current;              // Remember we came from 'current'
                 neighbor->gCost = newCostToNeighbor;     // Cost from start to neighbor
                 neighbor->hCost = calculateHCost(neighbor, end);  // Estimated cost to goal
+                if (neighbor->hCost == INFINITY) continue;      // Cut off from the goal
                 
                 // Add to open set for evaluation
-                openSet.push(neighbor);
+                pushOpen(neighbor);
             }
         }
     }
 
-    return path;
+    return false;
 }
 
-void AStarPathfinder::reconstructPath(Node* start, Node* end, std::vector<Node*>& path) {
-    Node* current = end;
-    while (current) {
-        path.push_back(current);
-        current = current->parent;
+void AStarPathfinder::reconstructPath(Node* start, Node* end, std::pmr::vector<Node*>& path) {
+    // Size it first so the path is written in one allocation, start to end
+    std::size_t length = 0;
+    for (Node* current = end; current; current = current->parent) {
+        length++;
+    }
+
+    path.resize(length);
+    for (Node* current = end; current; current = current->parent) {
+        path[--length] = current;
+    }
+}
+
+// === Jump point search ===
+// Open ground with uniform cost has many equally short paths between two
+// cells, and plain A* expands all of them. JPS only stops at cells where the
+// shortest path may have to turn (next to an obstacle corner) and walks
+// straight over everything in between. Cells that cost anything other than
+// 1.0, or border one, end a jump and have all their neighbours searched, so
+// frost areas get regular A*.
+
+bool AStarPathfinder::isOpen(int x, int y) {
+    return grid->isWalkable(x, y);
+}
+
+bool AStarPathfinder::isClear(int x, int y) {
+    Node* node = grid->getNode(x, y);
+    return node && node->walkable && node->getMovementCost() == 1.0f;
+}
+
+bool AStarPathfinder::isUniform(int x, int y) {
+    const int offsets[5][2] = {{0, 0}, {0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+    for (const auto& offset : offsets) {
+        Node* node = grid->getNode(x + offset[0], y + offset[1]);
+        if (node && node->walkable && node->getMovementCost() != 1.0f) return false;
+    }
+    return true;
+}
+
+bool AStarPathfinder::isHorizontalJumpPoint(int x, int y, int dx) {
+    // Frost (or frost next door) ends a jump so the cell gets a full expansion.
+    // A neighbour beside us that couldn't be reached as cheaply one step back
+    // means the path may turn here.
+    return !isUniform(x, y) ||
+           (isOpen(x, y - 1) && !isClear(x - dx, y - 1)) ||
+           (isOpen(x, y + 1) && !isClear(x - dx, y + 1));
+}
+
+void AStarPathfinder::refreshJumpTables() {
+    int width = grid->getWidth();
+    int height = grid->getHeight();
+
+    if (jumpLayoutVersion != grid->getLayoutVersion()) {
+        jumpRight.assign(static_cast<std::size_t>(width) * height, 0);
+        jumpLeft.assign(jumpRight.size(), 0);
+        jumpRowDirty.assign(height, 1);
+        jumpLayoutVersion = grid->getLayoutVersion();
+        jumpChangesRead = grid->getCostChangeCount();
+    }
+
+    // Changes we hadn't read were dropped from the log: redo every row
+    std::size_t changeCount = grid->getCostChangeCount();
+    if (jumpChangesRead < grid->getFirstCostChange()) {
+        std::fill(jumpRowDirty.begin(), jumpRowDirty.end(), 1);
+        jumpChangesRead = changeCount;
+    }
+
+    // A row's entries look at the rows above and below it
+    for (; jumpChangesRead < changeCount; jumpChangesRead++) {
+        int y = grid->getCostChange(jumpChangesRead).y;
+        for (int row = std::max(y - 1, 0); row <= std::min(y + 1, height - 1); row++) {
+            jumpRowDirty[row] = 1;
+        }
+    }
+
+    for (int y = 0; y < height; y++) {
+        if (jumpRowDirty[y]) {
+            rebuildJumpRow(y);
+            jumpRowDirty[y] = 0;
+        }
+    }
+}
+
+void AStarPathfinder::rebuildJumpRow(int y) {
+    int width = grid->getWidth();
+    int* right = &jumpRight[static_cast<std::size_t>(y) * width];
+    int* left = &jumpLeft[static_cast<std::size_t>(y) * width];
+
+    // Each entry follows from its neighbour further along the jump direction
+    for (int x = width - 1; x >= 0; x--) {
+        int next = (x + 1 < width) ? right[x + 1] : -1;
+        if (!isOpen(x, y)) right[x] = -1;
+        else if (isHorizontalJumpPoint(x, y, 1)) right[x] = 0;
+        else right[x] = next >= 0 ? next + 1 : next - 1;
+    }
+    for (int x = 0; x < width; x++) {
+        int next = (x > 0) ? left[x - 1] : -1;
+        if (!isOpen(x, y)) left[x] = -1;
+        else if (isHorizontalJumpPoint(x, y, -1)) left[x] = 0;
+        else left[x] = next >= 0 ? next + 1 : next - 1;
+    }
+}
+
+Node* AStarPathfinder::jumpHorizontal(int x, int y, int dx, Node* end) {
+    if (x < 0 || x >= grid->getWidth()) return nullptr;
+
+    int distance = (dx > 0 ? jumpRight : jumpLeft)[static_cast<std::size_t>(y) * grid->getWidth() + x];
+
+    // The goal ends a jump too, but isn't part of the table
+    if (y == end->y) {
+        int toEnd = (end->x - x) * dx;
+        if (toEnd >= 0 && (distance >= 0 ? toEnd <= distance : toEnd < -1 - distance)) return end;
+    }
+
+    return distance >= 0 ? grid->getNode(x + dx * distance, y) : nullptr;
+}
+
+Node* AStarPathfinder::jump(int x, int y, int dx, int dy, Node* end) {
+    if (dx != 0) return jumpHorizontal(x, y, dx, end);
+
+    while (true) {
+        if (!isOpen(x, y)) return nullptr;
+
+        Node* node = grid->getNode(x, y);
+        if (node == end || !isUniform(x, y)) return node;
+
+        if ((isOpen(x - 1, y) && !isClear(x - 1, y - dy)) || (isOpen(x + 1, y) && !isClear(x + 1, y - dy)))
+            return node;
+
+        // Moving vertically, a jump point anywhere along this row means turning here
+        if (jumpHorizontal(x + 1, y, 1, end) || jumpHorizontal(x - 1, y, -1, end))
+            return node;
+
+        y += dy;
+    }
+}
+
+bool AStarPathfinder::findJumpPointPath(Node* start, Node* end, std::pmr::vector<Node*>& path) {
+    refreshJumpTables();
+    beginSearch();
+
+    touch(start);
+    start->gCost = 0;
+    start->hCost = calculateHCost(start, end);
+    pushOpen(start);
+
+    while (!openEmpty()) {
+        Node* current = popOpen();
+        if (current->closed) continue;  // Older entry for a node reached again more cheaply
+        expandedNodes++;
+        if (current == end) {
+            reconstructJumpPath(start, end, path);
+            return true;
+        }
+
+        current->closed = true;
+
+        // Directions to search from here: straight on and both sides when
+        // arriving on uniform ground, all four at the start and around frost
+        int directions[4][2];
+        int directionCount = 0;
+        if (current->parent && isUniform(current->x, current->y)) {
+            int dx = (current->x > current->parent->x) - (current->x < current->parent->x);
+            int dy = (current->y > current->parent->y) - (current->y < current->parent->y);
+            directions[directionCount][0] = dx;
+            directions[directionCount++][1] = dy;
+            directions[directionCount][0] = dy;
+            directions[directionCount++][1] = dx;
+            directions[directionCount][0] = -dy;
+            directions[directionCount++][1] = -dx;
+        } else {
+            const int all[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+            for (const auto& direction : all) {
+                directions[directionCount][0] = direction[0];
+                directions[directionCount++][1] = direction[1];
+            }
+        }
+
+        for (int i = 0; i < directionCount; i++) {
+            int dx = directions[i][0], dy = directions[i][1];
+            Node* jumpPoint = jump(current->x + dx, current->y + dy, dx, dy, end);
+            if (!jumpPoint) continue;
+            touch(jumpPoint);
+            if (jumpPoint->closed) continue;
+
+            // Every cell skipped over cost 1.0; the jump point itself may not
+            int distance = std::abs(jumpPoint->x - current->x) + std::abs(jumpPoint->y - current->y);
+            float newCost = current->gCost + (distance - 1) + jumpPoint->getMovementCost();
+
+            if (jumpPoint->gCost == 0 || newCost < jumpPoint->gCost) {
+                jumpPoint->parent = current;
+                jumpPoint->gCost = newCost;
+                jumpPoint->hCost = calculateHCost(jumpPoint, end);
+                if (jumpPoint->hCost == INFINITY) continue;  // Cut off from the goal
+                pushOpen(jumpPoint);
+            }
+        }
+    }
+
+    return false;
+}
+
+void AStarPathfinder::reconstructJumpPath(Node* start, Node* end, std::pmr::vector<Node*>& path) {
+    // Parents are jump points in straight lines from each other; fill in the cells between
+    std::size_t length = 1;
+    for (Node* current = end; current->parent; current = current->parent) {
+        length += std::abs(current->x - current->parent->x) + std::abs(current->y - current->parent->y);
+    }
+
+    path.resize(length);
+    for (Node* current = end; current->parent; current = current->parent) {
+        int dx = (current->parent->x > current->x) - (current->parent->x < current->x);
+        int dy = (current->parent->y > current->y) - (current->parent->y < current->y);
+        for (int x = current->x, y = current->y; x != current->parent->x || y != current->parent->y; x += dx, y += dy) {
+            path[--length] = grid->getNode(x, y);
+        }
     }
-    std::reverse(path.begin(), path.end());
+    path[0] = start;
 }
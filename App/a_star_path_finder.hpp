@@ -1,19 +1,99 @@
 #pragma once
 #include <vector>
-#include <unordered_set>
+#include <memory_resource>
 #include "grid.hpp"
 #include "min_heap.hpp"
+#include "bucket_queue.hpp"
+#include "path_cache.hpp"
 
 class AStarPathfinder {
+public:
+    enum class SearchMode {
+        AStar,      // Expands every neighbour of every node
+        JumpPoint   // 4-connected JPS: skips along runs of uniform-cost cells, plain A* around frost
+    };
+
+    enum class OpenList {
+        BinaryHeap, // MinHeap: exact float ordering, O(log n)
+        Buckets     // BucketQueue: O(1), for costs that are multiples of BucketQueue::RESOLUTION
+    };
+
 private:
     Grid* grid;
     MinHeap openSet;
-    std::unordered_set<Node*> closedSet;
+    BucketQueue openBuckets;
+    SearchMode mode;
+    OpenList openList;
+    int expandedNodes = 0;  // Nodes taken off the open set by the last search
+
+    // Nodes carry the id of the search that last wrote them, so a search
+    // only resets the nodes it reaches instead of the whole grid
+    unsigned int searchId = 0;
+    void beginSearch();
+    void touch(Node* node);
+    void pushOpen(Node* node);
+    Node* popOpen();
+    bool openEmpty() const;
 
+    // Exact cost from every cell to Grid::endCell, from one backwards
+    // Dijkstra. Every query in the game goes to that cell, and with the true
+    // remaining cost as its heuristic A* only expands nodes on the best path.
+    // Recomputed on the first query after the goal or any cell's cost changes.
+    std::vector<float> goalDistances;
+    sf::Vector2i goalDistanceCell{-1, -1};
+    int goalDistanceLayout = -1;
+    std::size_t goalDistanceChanges = 0;
+    bool useGoalDistances = false;  // The current search targets goalDistanceCell
+    void refreshGoalDistances();
+
+    PathCache pathCache;
+    bool pathCacheEnabled = true;
+
+    bool search(Node* start, Node* end, std::pmr::vector<Node*>& path);
     float calculateHCost(Node* a, Node* b);
-    void reconstructPath(Node* start, Node* end, std::vector<Node*>& path);
+    void reconstructPath(Node* start, Node* end, std::pmr::vector<Node*>& path);
+
+    // === Jump point search ===
+    // Horizontal jumps are looked up instead of walked: for every cell, how
+    // far a jump starting there runs right/left before it stops at a jump
+    // point (d >= 0) or runs into a wall or the map edge at distance
+    // -1 - d. Rows are rebuilt from the grid's cost change log when needed.
+    std::vector<int> jumpRight, jumpLeft;
+    std::vector<char> jumpRowDirty;
+    int jumpLayoutVersion = -1;
+    std::size_t jumpChangesRead = 0;
+
+    bool isOpen(int x, int y);
+    bool isClear(int x, int y);    // Open and costs exactly 1.0
+    bool isUniform(int x, int y);  // The cell and its open neighbours all cost 1.0
+    bool isHorizontalJumpPoint(int x, int y, int dx);
+    void refreshJumpTables();
+    void rebuildJumpRow(int y);
+    Node* jumpHorizontal(int x, int y, int dx, Node* end);
+    Node* jump(int x, int y, int dx, int dy, Node* end);
+    bool findJumpPointPath(Node* start, Node* end, std::pmr::vector<Node*>& path);
+    void reconstructJumpPath(Node* start, Node* end, std::pmr::vector<Node*>& path);
 
 public:
-    AStarPathfinder(Grid* grid);
+    AStarPathfinder(Grid* grid, SearchMode mode = SearchMode::AStar, OpenList openList = OpenList::BinaryHeap);
+
+    void setSearchMode(SearchMode newMode) { mode = newMode; pathCache.clear(); }
+    SearchMode getSearchMode() const { return mode; }
+    OpenList getOpenList() const { return openList; }
+    int getExpandedNodes() const { return expandedNodes; }  // 0 when the last query was a cache hit
+
+    // Off for measuring the searches themselves
+    void setPathCacheEnabled(bool enabled) { pathCacheEnabled = enabled; pathCache.clear(); }
+    const PathCache& getPathCache() const { return pathCache; }
+
+    // Exact cost from (x, y) to Grid::endCell, INFINITY if it can't be reached
+    float getGoalDistance(int x, int y);
+
+    // Returns a path the caller can keep (enemies store theirs)
     std::vector<Node*> findPath(Node* start, Node* end);
+
+    // Writes the path into `path` and uses the thread's FrameArena for the
+    // search's scratch data; wrap calls in an ArenaScope to release it.
+    // Repeated queries on an unchanged grid are answered from the path cache
+    bool findPath(Node* start, Node* end, std::pmr::vector<Node*>& path);
 };
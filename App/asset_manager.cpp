@@ -1,4 +1,5 @@
 #include "asset_manager.hpp"
+#include "memory_tracker.hpp"
 
 bool AssetManager::loadTexture(const std::string& key, const std::string& filePath) {
     sf::Texture texture;
@@ -52,6 +53,7 @@ bool AssetManager::hasFont(const std::string& key) const {
 }
 
 void AssetManager::loadAllAssets() {
+    MemoryScope memory(MemoryTag::Assets);
     std::cout << "\n=== Loading All Assets ===" << std::endl;
     
     // Load fonts
@@ -130,4 +132,13 @@ void AssetManager::loadAllAssets() {
     std::cout << "=== Asset Loading Complete ===" << std::endl;
     std::cout << "Textures loaded: " << textures.size() << std::endl;
     std::cout << "Fonts loaded: " << fonts.size() << std::endl << std::endl;
-}
\ No newline at end of file
+}
+
+std::size_t AssetManager::estimateTextureBytes() const {
+    // RGBA8 as uploaded; the driver may pad or keep a second copy
+    std::size_t bytes = 0;
+    for (const auto& [key, texture] : textures) {
+        bytes += static_cast<std::size_t>(texture.getSize().x) * texture.getSize().y * 4;
+    }
+    return bytes;
+}
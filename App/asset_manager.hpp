@@ -24,4 +24,5 @@ public:
 
     // Utility
     void loadAllAssets();  // Load all game assets at once
+    std::size_t estimateTextureBytes() const;  // Video memory held by loaded textures
 };
\ No newline at end of file
@@ -36,10 +36,10 @@ bool BarrierTower::isDestroyed() const {
     return durability <= 0;
 }
 
-void BarrierTower::draw(sf::RenderWindow& window) {
+void BarrierTower::draw(RenderList& out) {
     if (baseSprite) {
-        window.draw(*baseSprite);
+        out.add(*baseSprite);
     } else {
-        window.draw(shape);
+        out.add(shape);
     }
 }
@@ -12,7 +12,7 @@ public:
 
     // Implement pure virtual functions from Tower
     void update(float deltaTime, std::vector<std::unique_ptr<Enemy>>& enemies) override;
-    void draw(sf::RenderWindow& window) override;
+    void draw(RenderList& out) override;
     
     // Barrier-specific methods
     void takeDamage(int damage);
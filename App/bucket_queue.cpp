@@ -0,0 +1,108 @@
+#include "bucket_queue.hpp"
+#include <cmath>
+#include <algorithm>
+
+namespace {
+    constexpr std::size_t INITIAL_BUCKETS = 64;
+
+    // Index of the lowest set bit (de Bruijn multiply), without compiler intrinsics
+    int lowestBit(std::uint64_t bits) {
+        static constexpr int table[64] = {
+         0,  1, 48,  2, 57, 49, 28,  3,
+        61, 58, 50, 42, 38, 29, 17,  4,
+        62, 55, 59, 36, 53, 51, 43, 22,
+        45, 39, 33, 30, 24, 18, 12,  5,
+        63, 47, 56, 27, 60, 41, 37, 16,
+        54, 35, 52, 21, 44, 32, 23, 11,
+        46, 26, 40, 15, 34, 20, 31, 10,
+        25, 14, 19,  9, 13,  8,  7,  6
+        };
+        return table[((bits & (~bits + 1)) * 0x03F79D71B4CB0A89ull) >> 58];
+    }
+}
+
+BucketQueue::BucketQueue()
+    : buckets(INITIAL_BUCKETS), occupied(INITIAL_BUCKETS / 64), mask(INITIAL_BUCKETS - 1) {}
+
+long long BucketQueue::keyOf(float priority) {
+    // Priorities are never negative, so adding a half and truncating rounds
+    // (and is much cheaper than llround)
+    return static_cast<long long>(priority * (1.0f / RESOLUTION) + 0.5f);
+}
+
+void BucketQueue::push(Node* node, float priority) {
+    long long key = keyOf(priority);
+    if (!popped) {
+        // Nothing has been taken out yet, so the queue can still start lower
+        if (count == 0 || key < current) current = key;
+        highest = (count == 0) ? key : std::max(highest, key);
+    } else {
+        key = std::max(key, current);
+        highest = std::max(highest, key);
+    }
+    if (highest - current >= static_cast<long long>(buckets.size())) grow();
+
+    std::size_t index = static_cast<std::size_t>(key) & mask;
+    buckets[index].push_back({key, {priority, node}});
+    occupied[index / 64] |= std::uint64_t(1) << (index % 64);
+    count++;
+}
+
+BucketQueue::Entry BucketQueue::pop() {
+    if (count == 0) return {0.f, nullptr};
+
+    popped = true;
+    current = nextOccupied();
+    std::size_t index = static_cast<std::size_t>(current) & mask;
+    std::vector<Slot>& bucket = buckets[index];
+    Entry top = bucket.back().entry;
+    bucket.pop_back();
+    if (bucket.empty()) occupied[index / 64] &= ~(std::uint64_t(1) << (index % 64));
+    count--;
+    return top;
+}
+
+long long BucketQueue::nextOccupied() const {
+    std::size_t start = static_cast<std::size_t>(current) & mask;
+    std::size_t word = start / 64;
+    std::uint64_t bits = occupied[word] & (~std::uint64_t(0) << (start % 64));
+
+    // The queue isn't empty, so this finds a bit within one lap. Coming back
+    // round to the first word, the bits before start are a lap ahead
+    while (bits == 0) {
+        word = (word + 1) % occupied.size();
+        bits = occupied[word];
+    }
+
+    std::size_t index = word * 64 + static_cast<std::size_t>(lowestBit(bits));
+    return current + static_cast<long long>((index - start) & mask);
+}
+
+// Double the ring until every key from current to highest has its own
+// bucket, moving each entry to its bucket in the larger ring
+void BucketQueue::grow() {
+    std::size_t size = buckets.size();
+    while (highest - current >= static_cast<long long>(size)) size *= 2;
+
+    std::vector<std::vector<Slot>> old = std::move(buckets);
+    buckets = std::vector<std::vector<Slot>>(size);
+    occupied.assign(size / 64, 0);
+    mask = size - 1;
+    for (std::vector<Slot>& bucket : old) {
+        for (const Slot& slot : bucket) {
+            std::size_t index = static_cast<std::size_t>(slot.key) & mask;
+            buckets[index].push_back(slot);
+            occupied[index / 64] |= std::uint64_t(1) << (index % 64);
+        }
+    }
+}
+
+void BucketQueue::clear() {
+    if (count > 0) {
+        for (std::vector<Slot>& bucket : buckets) bucket.clear();
+        std::fill(occupied.begin(), occupied.end(), 0);
+    }
+    count = 0;
+    current = highest = 0;
+    popped = false;
+}
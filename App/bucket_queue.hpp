@@ -0,0 +1,53 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "node.hpp"
+
+// Monotone bucket queue (Dial's algorithm) for searches whose priorities
+// never drop below the last one popped, as in A* with a consistent
+// heuristic or Dijkstra. Priorities are rounded to RESOLUTION and each
+// bucket holds one rounded value, so push and pop are O(1) instead of
+// O(log n). Movement costs are 1.0, or 1.5/1.7 on frost, so the sums the
+// searches use are all multiples of 0.1 and the rounding loses nothing.
+//
+// Buckets form a ring that doubles when a push lands further ahead than
+// it reaches. Equal priorities come out last-in-first-out, which favours
+// the most recently reached (usually deepest) node as MinHeap's smaller-h
+// tie-break does. Once something has been popped, a push below the
+// current bucket is treated as the current bucket.
+class BucketQueue {
+public:
+    static constexpr float RESOLUTION = 0.1f;
+
+    struct Entry {
+        float priority;
+        Node* node;
+    };
+
+private:
+    struct Slot {
+        long long key;
+        Entry entry;
+    };
+
+    std::vector<std::vector<Slot>> buckets;  // Kept between searches so steady state doesn't allocate
+    std::vector<std::uint64_t> occupied;     // One bit per non-empty bucket, so pop skips empty runs a word at a time
+    std::size_t mask;
+    long long current = 0;  // Key of the lowest bucket that may hold anything
+    long long highest = 0;  // Highest key pushed since clear()
+    std::size_t count = 0;
+    bool popped = false;    // Since clear(); until then a push may still lower `current`
+
+    static long long keyOf(float priority);
+    void grow();
+    long long nextOccupied() const;  // Key of the first non-empty bucket at or after current
+
+public:
+    BucketQueue();
+
+    void push(Node* node, float priority);
+    void push(Node* node) { push(node, node->getFCost()); }
+    Entry pop();  // {0, nullptr} when empty
+    bool empty() const { return count == 0; }
+    void clear();
+};
@@ -0,0 +1,28 @@
+#include "damage_queue.hpp"
+#include "enemy.hpp"
+#include <algorithm>
+
+void DamageQueue::push(const DamageEvent& event) {
+    std::lock_guard<std::mutex> lock(mutex);
+    events.push_back(event);
+}
+
+void DamageQueue::resolve(std::vector<std::unique_ptr<Enemy>>& enemies) {
+    std::sort(events.begin(), events.end(), [](const DamageEvent& a, const DamageEvent& b) {
+        if (a.sourceId != b.sourceId) return a.sourceId < b.sourceId;
+        return a.targetId < b.targetId;
+    });
+
+    for (const DamageEvent& event : events) {
+        auto it = std::lower_bound(enemies.begin(), enemies.end(), event.targetId,
+                                   [](const std::unique_ptr<Enemy>& e, int id) { return e->getId() < id; });
+        if (it == enemies.end() || (*it)->getId() != event.targetId) continue;
+
+        // Already killed by an earlier event this tick
+        if ((*it)->isDead()) continue;
+
+        (*it)->takeDamage(event.amount);
+    }
+
+    events.clear();
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <mutex>
+
+class Enemy;
+
+struct DamageEvent {
+    int sourceId;     // Projectile that dealt the damage
+    int targetId;     // Enemy::getId() of the receiver
+    int amount;
+};
+
+// Per-tick command buffer for damage. Hits are recorded while projectiles are
+// processed (possibly from several threads) and applied in one ordered pass,
+// so the result never depends on iteration or thread scheduling order.
+class DamageQueue {
+private:
+    std::vector<DamageEvent> events;
+    std::mutex mutex;
+
+public:
+    void push(const DamageEvent& event);  // Thread-safe
+
+    // Apply all recorded events ordered by (source, target) and clear the
+    // buffer. Expects enemies to be sorted by ID, which spawn order guarantees.
+    // Hits are chosen against the enemies alive at the start of the tick, so
+    // a hit on an enemy an earlier event already killed is dropped; the
+    // projectile is still spent rather than passing on to another enemy.
+    void resolve(std::vector<std::unique_ptr<Enemy>>& enemies);
+
+    bool empty() const { return events.empty(); }
+    void clear() { events.clear(); }
+};
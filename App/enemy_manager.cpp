@@ -1,7 +1,11 @@
 #include "enemy_manager.hpp"
 #include "asset_manager.hpp"
-#include <cstdlib>
+#include "job_system.hpp"
+#include "profiler.hpp"
+#include "memory_tracker.hpp"
+#include "grid_units.hpp"
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 
 
@@ -20,24 +24,80 @@ EnemyManager::EnemyManager(Grid *grid, AStarPathfinder *pathfinder, AssetManager
     }
 }
 
+void EnemyManager::setPathService(PathService *service)
+{
+    pathService = service;
+    if (!pathService)
+        return;
+
+    // Plan from wherever the enemy is when the request is served
+    pathService->setHandlers(
+        [this](int id, std::vector<Node *> &path, std::vector<Node *> &waypoints)
+        {
+            Enemy *enemy = findEnemy(id);
+            if (!enemy)
+                return false;
+            sf::Vector2i cell = worldToCell(enemy->getPosition());
+            Node *enemyNode = grid->getNode(cell.x, cell.y);
+            return enemyNode && planPath(enemyNode, path, waypoints);
+        },
+        [this](int id, const std::vector<Node *> &path, const std::vector<Node *> &waypoints)
+        {
+            if (Enemy *enemy = findEnemy(id))
+            {
+                enemy->setPath(path);
+                enemy->setWaypoints(waypoints);
+            }
+        });
+}
+
 void EnemyManager::update(float deltaTime)
 {
-    if (enemiesToSpawn > 0 && spawnClock.getElapsedTime().asSeconds() >= spawnInterval)
+    MemoryScope memory(MemoryTag::Enemies);
+    rerouteAffectedEnemies();
+    if (pathService)
+        pathService->update();  // New paths land before anyone moves this tick
+    updateMovement(deltaTime);
+    clearDeadEnemies();
+
+    ScopedTimer timer("TargetIndex");
+    targetIndex.rebuild(enemies, grid->getWidth(), grid->getHeight());
+}
+
+void EnemyManager::updateMovement(float deltaTime)
+{
+    ScopedTimer timer("Enemies");
+
+    if (hierarchy)
+        refineRoutes();
+
+    spawnTimer += deltaTime;
+    if (enemiesToSpawn > 0 && spawnTimer >= spawnInterval)
     {
         spawnEnemy();
-        spawnClock.restart();
+        spawnTimer = 0.0f;
     }
 
-    for (auto &enemy : enemies)
-        enemy->update(deltaTime);
-
-    clearDeadEnemies();
+    // Enemies only touch their own state while moving, so chunks run in parallel
+    auto moveEnemies = [this, deltaTime](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; i++)
+            enemies[i]->update(deltaTime);
+    };
+    if (jobSystem)
+        jobSystem->parallelFor(enemies.size(), 64, moveEnemies);
+    else
+        moveEnemies(0, enemies.size());
 }
 
-void EnemyManager::draw(sf::RenderWindow &window)
+void EnemyManager::draw(RenderList &out, const sf::FloatRect &visibleArea)
 {
+    ScopedTimer timer("EnemyDraw");
     for (auto &enemy : enemies)
-        enemy->draw(window);
+    {
+        if (visibleArea.contains(enemy->getPosition()))
+            enemy->draw(out);
+    }
 }
 
 void EnemyManager::spawnWave(int count, float interval)
@@ -45,7 +105,7 @@ void EnemyManager::spawnWave(int count, float interval)
     enemiesToSpawn = count;
     spawnInterval = interval;
     enemiesSpawned = 0;
-    spawnClock.restart();
+    spawnTimer = 0.0f;
 }
 
 void EnemyManager::spawnEnemy()
@@ -59,7 +119,7 @@ void EnemyManager::spawnEnemy()
         Node *start = grid->getNode(grid->getStart().x, grid->getStart().y);
         Node *end = grid->getNode(grid->getEnd().x, grid->getEnd().y);
         if (start && end) {
-            cachedPath = pathfinder->findPath(start, end);
+            planPath(start, cachedPath, cachedWaypoints);
             std::cout << "Recalculated path. Path size: " << cachedPath.size() << std::endl;
         }
         
@@ -70,7 +130,7 @@ void EnemyManager::spawnEnemy()
         }
     }
 
-    int type = std::rand() % 4;
+    int type = std::uniform_int_distribution<int>(0, 3)(rng);
     std::unique_ptr<Enemy> e;
 
     switch (type)
@@ -145,6 +205,8 @@ void EnemyManager::spawnEnemy()
         break;
     }
 
+    e->setWaypoints(cachedWaypoints);
+    e->setId(nextEnemyId++);
     enemies.push_back(std::move(e));
     enemiesToSpawn--;
     enemiesSpawned++;
@@ -152,6 +214,7 @@ void EnemyManager::spawnEnemy()
 
 void EnemyManager::clearDeadEnemies()
 {
+    ScopedTimer timer("ClearDead");
     enemies.erase(std::remove_if(enemies.begin(), enemies.end(),
                                  [this](const std::unique_ptr<Enemy> &e)
                                  {
@@ -164,8 +227,185 @@ void EnemyManager::clearDeadEnemies()
                   enemies.end());
 }
 
+bool EnemyManager::planPath(Node *from, std::vector<Node *> &path, std::vector<Node *> &waypoints)
+{
+    Node *end = grid->getNode(grid->getEnd().x, grid->getEnd().y);
+    waypoints.clear();
+
+    if (!hierarchy || !hierarchy->isActive())
+    {
+        path = pathfinder->findPath(from, end);
+        return !path.empty();
+    }
+
+    path.clear();
+    hierarchy->update();
+    if (!hierarchy->findRoute(from, end, waypoints))
+        return false;
+
+    // Refine just the first few clusters; refineRoutes() does the rest on the way
+    path.push_back(from);
+    std::size_t refined = 0;
+    while (refined < waypoints.size() && static_cast<int>(path.size()) < REFINE_LOOKAHEAD)
+    {
+        if (!hierarchy->refineSegment(path.back(), waypoints[refined++], path))
+        {
+            path.clear();
+            waypoints.clear();
+            return false;
+        }
+    }
+    waypoints.erase(waypoints.begin(), waypoints.begin() + refined);
+    return true;
+}
+
+void EnemyManager::repathEnemy(Enemy &enemy)
+{
+    // Plan from the enemy's current grid position
+    sf::Vector2i cell = worldToCell(enemy.getPosition());
+    Node *enemyNode = grid->getNode(cell.x, cell.y);
+    if (!enemyNode)
+        return;
+
+    std::vector<Node *> newPath, waypoints;
+    if (planPath(enemyNode, newPath, waypoints))
+    {
+        enemy.setPath(newPath);
+        enemy.setWaypoints(waypoints);
+    }
+}
+
+Enemy *EnemyManager::findEnemy(int id)
+{
+    auto it = std::lower_bound(enemies.begin(), enemies.end(), id,
+                               [](const std::unique_ptr<Enemy> &e, int value) { return e->getId() < value; });
+    return (it != enemies.end() && (*it)->getId() == id) ? it->get() : nullptr;
+}
+
+void EnemyManager::refineRoutes()
+{
+    ScopedTimer timer("RefineRoutes");
+    for (auto &enemy : enemies)
+    {
+        while (enemy->hasPendingWaypoints() && enemy->getRemainingNodes() < REFINE_LOOKAHEAD)
+        {
+            refineBuffer.clear();
+            if (!hierarchy->refineSegment(enemy->getPathEnd(), enemy->takeWaypoint(), refineBuffer))
+            {
+                repathEnemy(*enemy);  // The grid changed under the route
+                break;
+            }
+            enemy->extendPath(refineBuffer);
+        }
+    }
+}
+
+void EnemyManager::rerouteAffectedEnemies()
+{
+    std::size_t changeCount = grid->getCostChangeCount();
+    if (costLayoutVersion == grid->getLayoutVersion() && costChangesRead == changeCount)
+        return;
+    if (costLayoutVersion != grid->getLayoutVersion() || costChangesRead < grid->getFirstCostChange())
+    {
+        recalculatePaths();  // A new map, or changes we never saw: every route is suspect
+        return;
+    }
+
+    ScopedTimer timer("CostChanges");
+    int width = grid->getWidth();
+
+    // Net effect per cell over the batch, so a change that was undone (a
+    // rejected placement blocks a cell and frees it again) counts for nothing
+    std::size_t cellCount = static_cast<std::size_t>(width) * grid->getHeight();
+    if (costBefore.size() != cellCount)
+        costBefore.assign(cellCount, NAN);
+    changedCells.clear();
+    for (std::size_t i = costChangesRead; i < changeCount; i++)
+    {
+        const Grid::CostChange &change = grid->getCostChange(i);
+        int cell = change.y * width + change.x;
+        if (std::isnan(costBefore[cell]))
+        {
+            costBefore[cell] = change.oldCost;
+            changedCells.push_back(cell);
+        }
+    }
+    costChangesRead = changeCount;
+
+    bool decreased = false;
+    std::size_t netChanged = 0;
+    for (int cell : changedCells)
+    {
+        float before = costBefore[cell];
+        float now = Grid::crossingCost(*grid->getNode(cell % width, cell / width));
+        costBefore[cell] = NAN;
+        if (now == before || std::abs(now - before) < 1e-4f)
+            continue;
+        decreased = decreased || now < before;
+        changedCells[netChanged++] = cell;
+    }
+    changedCells.resize(netChanged);
+
+    // A cell that got cheaper can pull routes that never touched it, so
+    // checking routes one by one only works when every change is an increase
+    if (decreased)
+    {
+        recalculatePaths();
+        return;
+    }
+    if (changedCells.empty())
+        return;
+
+    bool clustered = hierarchy && hierarchy->isActive();
+    int clusterSize = HierarchicalPathfinder::CLUSTER_SIZE;
+    int clustersX = (width + clusterSize - 1) / clusterSize;
+    auto areaOf = [&](int x, int y)
+    {
+        return clustered ? (y / clusterSize) * clustersX + x / clusterSize : y * width + x;
+    };
+
+    std::size_t areaCount = clustered ? static_cast<std::size_t>(clustersX) * ((grid->getHeight() + clusterSize - 1) / clusterSize)
+                                      : static_cast<std::size_t>(width) * grid->getHeight();
+    if (changedAreas.size() != areaCount)
+        changedAreas.assign(areaCount, 0);
+    for (int cell : changedCells)
+        changedAreas[areaOf(cell % width, cell / width)] = 1;
+
+    auto crossesChange = [&](const Node *node) { return changedAreas[areaOf(node->x, node->y)] != 0; };
+
+    // New spawns need the new route straight away
+    bool spawnRouteChanged = false;
+    for (const Node *node : cachedPath)
+        spawnRouteChanged = spawnRouteChanged || crossesChange(node);
+    for (const Node *node : cachedWaypoints)
+        spawnRouteChanged = spawnRouteChanged || crossesChange(node);
+    if (spawnRouteChanged || cachedPath.empty())
+    {
+        Node *start = grid->getNode(grid->getStart().x, grid->getStart().y);
+        if (start)
+            planPath(start, cachedPath, cachedWaypoints);
+    }
+
+    for (auto &enemy : enemies)
+    {
+        if (!enemy->anyNodeAhead(crossesChange))
+            continue;
+        if (pathService)
+            pathService->request(enemy->getId());
+        else
+            repathEnemy(*enemy);
+    }
+
+    for (int cell : changedCells)
+        changedAreas[areaOf(cell % width, cell / width)] = 0;
+}
+
 void EnemyManager::recalculatePaths()
 {
+    MemoryScope memory(MemoryTag::Enemies);
+    costLayoutVersion = grid->getLayoutVersion();  // Everything below is planned against the current log
+    costChangesRead = grid->getCostChangeCount();
+
     Node *end = grid->getNode(grid->getEnd().x, grid->getEnd().y);
     if (!end)
         return;
@@ -173,25 +413,16 @@ void EnemyManager::recalculatePaths()
     // Recalculate the cached path from start to end (for new spawns)
     Node *start = grid->getNode(grid->getStart().x, grid->getStart().y);
     if (start)
-        cachedPath = pathfinder->findPath(start, end);
+        planPath(start, cachedPath, cachedWaypoints);
 
-    // For each existing enemy, recalculate path from THEIR current position
+    // For each existing enemy, recalculate path from THEIR current position.
+    // With a path service they keep walking their old path until it's their turn
     for (auto &enemy : enemies)
     {
-        // Get enemy's current grid position
-        sf::Vector2f enemyPos = enemy->getPosition();
-        int gridX = static_cast<int>(enemyPos.x / 48.0f);
-        int gridY = static_cast<int>(enemyPos.y / 48.0f);
-        
-        Node *enemyNode = grid->getNode(gridX, gridY);
-        if (!enemyNode)
-            continue;
-
-        // Find path from enemy's current position to the end
-        std::vector<Node*> newPath = pathfinder->findPath(enemyNode, end);
-        
-        if (!newPath.empty())
-            enemy->setPath(newPath);
+        if (pathService)
+            pathService->request(enemy->getId());
+        else
+            repathEnemy(*enemy);
     }
 }
 
@@ -2,40 +2,83 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <memory>
+#include <random>
 #include "enemy.hpp"
 #include "a_star_path_finder.hpp"
+#include "hierarchical_pathfinder.hpp"
+#include "path_service.hpp"
+#include "target_index.hpp"
 #include "grid.hpp"
 
 class AssetManager;  // Forward declaration
+class JobSystem;
 
 class EnemyManager
 {
 private:
     Grid *grid;
     AStarPathfinder *pathfinder;
+    HierarchicalPathfinder *hierarchy = nullptr;  // Used instead of pathfinder on large maps
+    PathService *pathService = nullptr;           // Spreads repaths over ticks; null repaths immediately
     AssetManager *assetManager;  // Add asset manager pointer
+    JobSystem *jobSystem = nullptr;
     std::vector<std::unique_ptr<Enemy>> enemies;
     std::vector<Node *> cachedPath;
+    std::vector<Node *> cachedWaypoints;  // Unrefined rest of cachedPath on large maps
+    std::vector<Node *> refineBuffer;     // Reused by refineRoutes()
+    TargetIndex targetIndex;              // Rebuilt at the end of every update, for the towers' next targeting pass
 
-    sf::Clock spawnClock;
+    // Hierarchical paths are refined while an enemy has fewer cells than this left
+    static constexpr int REFINE_LOOKAHEAD = HierarchicalPathfinder::CLUSTER_SIZE;
+
+    float spawnTimer = 0.0f;  // Simulation time since the last spawn (not wall time, so fast-forward works)
     float spawnInterval;
     int enemiesToSpawn;
     int enemiesSpawned;
+    int nextEnemyId = 0;  // IDs increase with spawn order, keeping enemies sorted by ID
+    std::mt19937 rng;     // Enemy type rolls; seeded so scenarios replay identically
     
     int enemiesReachedGoal = 0;  // Track enemies that reached goal this frame
 
+    void updateMovement(float deltaTime);  // Spawning and moving, before dead enemies are cleared
+
+    // Path from `from` to the goal. On large maps `path` only covers the next
+    // few clusters and `waypoints` holds the coarse route past it
+    bool planPath(Node *from, std::vector<Node *> &path, std::vector<Node *> &waypoints);
+    void repathEnemy(Enemy &enemy);
+    Enemy *findEnemy(int id);
+    void refineRoutes();
+
+    // Reads the grid's cost change log each tick and compares each changed
+    // cell's cost now with its cost before the batch. While every net change
+    // is an increase, only routes that cross a changed cell (a changed
+    // cluster on large maps) are replanned, as any other route is still the
+    // cheapest. A decrease, or a log that moved on without us, replans everyone
+    int costLayoutVersion = -1;
+    std::size_t costChangesRead = 0;
+    std::vector<float> costBefore;   // Per cell, NAN unless changed in the batch being read
+    std::vector<int> changedCells;   // Cells whose cost changed, net, in that batch
+    std::vector<char> changedAreas;  // Per cell, or per cluster on large maps; cleared after each check
+    void rerouteAffectedEnemies();
+
 public:
     EnemyManager(Grid *grid, AStarPathfinder *pathfinder, AssetManager *assets = nullptr);
 
+    void setJobSystem(JobSystem *jobs) { jobSystem = jobs; }
+    void setHierarchicalPathfinder(HierarchicalPathfinder *hpa) { hierarchy = hpa; }
+    void setPathService(PathService *service);
+    void setSeed(unsigned int seed) { rng.seed(seed); }
+
     void update(float deltaTime);
-    void draw(sf::RenderWindow &window);
+    void draw(RenderList &out, const sf::FloatRect &visibleArea);  // Skips enemies outside visibleArea
 
     void spawnEnemy(); // Spawns one enemy
     void spawnWave(int count, float interval);
     void clearDeadEnemies();
-    void recalculatePaths(); // Repath all active enemies
+    void recalculatePaths(); // Replan every route (new map); active enemies are queued on the path service if there is one
 
     bool allEnemiesDefeated() const;
     const std::vector<std::unique_ptr<Enemy>> &getEnemies() const;
+    const TargetIndex &getTargetIndex() const { return targetIndex; }
     int getReachedGoalCount();  // Get and reset count of enemies that reached goal
 };
@@ -0,0 +1,86 @@
+#include "frame_arena.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+
+namespace {
+    // Every thread's arena, so the main thread can reset them all between ticks
+    std::mutex registryMutex;
+    std::vector<FrameArena*>& registry() {
+        static std::vector<FrameArena*> arenas;
+        return arenas;
+    }
+}
+
+FrameArena::FrameArena() {
+    blocks.push_back({std::make_unique<std::byte[]>(INITIAL_BLOCK_SIZE), INITIAL_BLOCK_SIZE});
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    registry().push_back(this);
+}
+
+FrameArena::~FrameArena() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto& arenas = registry();
+    arenas.erase(std::remove(arenas.begin(), arenas.end(), this), arenas.end());
+}
+
+FrameArena& FrameArena::local() {
+    thread_local FrameArena arena;
+    return arena;
+}
+
+void FrameArena::resetAll() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (FrameArena* arena : registry()) {
+        arena->reset();
+    }
+}
+
+void* FrameArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+    while (true) {
+        Block& block = blocks[currentBlock];
+        std::uintptr_t base = reinterpret_cast<std::uintptr_t>(block.data.get());
+        std::size_t start = (base + offset + alignment - 1) / alignment * alignment - base;
+        if (start + bytes <= block.size) {
+            offset = start + bytes;
+            highWater = std::max(highWater, bytesInUse());
+            return block.data.get() + start;
+        }
+
+        // Move on to the next block, growing the arena if there isn't one
+        currentBlock++;
+        offset = 0;
+        if (currentBlock == blocks.size()) {
+            std::size_t size = std::max(blocks.back().size * 2, bytes + alignment);
+            blocks.push_back({std::make_unique<std::byte[]>(size), size});
+        }
+    }
+}
+
+std::size_t FrameArena::bytesInUse() const {
+    std::size_t used = offset;
+    for (std::size_t i = 0; i < currentBlock; i++) {
+        used += blocks[i].size;
+    }
+    return used;
+}
+
+void FrameArena::rewind(Marker marker) {
+    currentBlock = marker.block;
+    offset = marker.offset;
+}
+
+void FrameArena::reset() {
+    currentBlock = 0;
+    offset = 0;
+    highWater = 0;
+}
+
+std::size_t FrameArena::getCapacity() const {
+    std::size_t capacity = 0;
+    for (const Block& block : blocks) {
+        capacity += block.size;
+    }
+    return capacity;
+}
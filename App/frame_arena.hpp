@@ -0,0 +1,75 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+// Bump allocator for scratch data that never outlives a tick. Allocation is a
+// pointer bump, deallocation is a no-op, and resetAll() at the start of every
+// tick makes all of it reusable. Blocks are kept between ticks, so once the
+// arena has grown to the busiest tick's needs it stops touching the heap.
+//
+// Each thread has its own arena (local()), so job chunks can use it without
+// locking. Hand it to containers as a std::pmr::memory_resource.
+class FrameArena : public std::pmr::memory_resource {
+public:
+    // Position to rewind to; see ArenaScope
+    struct Marker {
+        std::size_t block;
+        std::size_t offset;
+    };
+
+private:
+    static constexpr std::size_t INITIAL_BLOCK_SIZE = 64 * 1024;
+
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size;
+    };
+
+    std::vector<Block> blocks;
+    std::size_t currentBlock = 0;
+    std::size_t offset = 0;      // Bytes used in blocks[currentBlock]
+    std::size_t highWater = 0;   // Most bytes in use at once since the last reset
+
+    std::size_t bytesInUse() const;
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void*, std::size_t, std::size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+public:
+    FrameArena();
+    ~FrameArena() override;
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    static FrameArena& local();  // This thread's arena
+    static void resetAll();      // Only while no thread is using its arena (start of a tick)
+
+    Marker mark() const { return {currentBlock, offset}; }
+    void rewind(Marker marker);
+    void reset();
+
+    std::size_t getCapacity() const;
+    std::size_t getHighWater() const { return highWater; }
+};
+
+// Frees everything allocated from the arena during its lifetime, so helpers
+// called many times per tick (findPath) don't accumulate scratch space
+class ArenaScope {
+private:
+    FrameArena& arena;
+    FrameArena::Marker marker;
+
+public:
+    explicit ArenaScope(FrameArena& arena = FrameArena::local()) : arena(arena), marker(arena.mark()) {}
+    ~ArenaScope() { arena.rewind(marker); }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+    FrameArena* resource() const { return &arena; }
+};
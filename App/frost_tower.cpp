@@ -1,5 +1,6 @@
 #include "frost_tower.hpp"
 #include <cmath>
+#include "grid_units.hpp"
 
 FrostTower::FrostTower(sf::Vector2f pos, Grid* grid, float range, float fireRate,
                        int cost, float slowMultiplier, int aoeRangeCells)
@@ -7,47 +8,54 @@ FrostTower::FrostTower(sf::Vector2f pos, Grid* grid, float range, float fireRate
       slowMultiplier(slowMultiplier),
       aoeRangeCells(aoeRangeCells),
       pathCostIncrease(0.0f),
-      grid(grid)
+      grid(grid),
+      frostApplied(false)
 {
-    aoeVisual.setSize(sf::Vector2f(aoeRangeCells * 2 * 48.f, aoeRangeCells * 2 * 48.f));
+    aoeVisual.setSize(sf::Vector2f(aoeRangeCells * 2 * CELL_SIZE, aoeRangeCells * 2 * CELL_SIZE));
     aoeVisual.setOrigin(aoeVisual.getSize() / 2.0f);
     aoeVisual.setPosition(position);
     aoeVisual.setFillColor(sf::Color(0, 150, 255, 60));
 }
 
 void FrostTower::update(float deltaTime, std::vector<std::unique_ptr<Enemy>>& enemies) {
-    // Apply AoE slow effect every frame (since frost towers are passive)
-    if (grid) {
-        applyFrostEffects();
-    }
+    // Frost towers never move, so their slow lives in the grid's static
+    // frost field and is only touched on placement/removal.
 
     // Update cooldown (even though FrostTower doesn't shoot)
     if (cooldown > 0)
         cooldown -= deltaTime;
 }
 
-void FrostTower::draw(sf::RenderWindow& window) {
+void FrostTower::draw(RenderList& out) {
     // Draw AoE visualization
-    window.draw(aoeVisual);
+    out.add(aoeVisual);
 
     // Draw tower sprite or fallback to circle
     if (baseSprite) {
-        window.draw(*baseSprite);
+        out.add(*baseSprite);
     } else {
         sf::CircleShape towerBase(16);
         towerBase.setOrigin({16.f, 16.f});
         towerBase.setPosition(position);
         towerBase.setFillColor(sf::Color(100, 180, 255));
-        window.draw(towerBase);
+        out.add(towerBase);
     }
 }
 
 void FrostTower::applyFrostEffects() {
-    if (!grid) return;
+    if (!grid || frostApplied) return;
+
+    sf::Vector2i center = worldToCell(position);
+
+    grid->applyFrostEffect(center.x, center.y, aoeRangeCells, slowMultiplier);
+    frostApplied = true;
+}
+
+void FrostTower::removeFrostEffects() {
+    if (!grid || !frostApplied) return;
 
-    // Convert world position to grid cell indices
-    int centerX = static_cast<int>(position.x / 48);
-    int centerY = static_cast<int>(position.y / 48);
+    sf::Vector2i center = worldToCell(position);
 
-    grid->applyFrostEffect(centerX, centerY, aoeRangeCells, slowMultiplier);
+    grid->removeFrostEffect(center.x, center.y, aoeRangeCells, slowMultiplier);
+    frostApplied = false;
 }
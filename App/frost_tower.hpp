@@ -9,13 +9,15 @@ private:
     float pathCostIncrease;    // optional modifier for pathfinding
     sf::RectangleShape aoeVisual;
     Grid* grid;                // pointer for applying frost effects
+    bool frostApplied;         // whether our slow is currently part of the grid's frost field
 
 public:
     FrostTower(sf::Vector2f pos, Grid* grid, float range, float fireRate,
                int cost, float slowMultiplier, int aoeRangeCells);
 
     void update(float deltaTime, std::vector<std::unique_ptr<Enemy>>& enemies) override;
-    void draw(sf::RenderWindow& window) override;
+    void draw(RenderList& out) override;
 
-    void applyFrostEffects();   // triggers Grid::applyFrostEffects
+    void applyFrostEffects();   // adds this tower's slow to the grid (call once on placement)
+    void removeFrostEffects();  // takes it back out (call when the tower is removed)
 };
@@ -1,20 +1,57 @@
 #include "game_manager.hpp"
 #include <algorithm>
 #include <iostream>
-
-GameManager::GameManager()
-    : window(sf::VideoMode({GRID_WIDTH * CELL_SIZE + UI_PANEL_WIDTH,
-                           GRID_HEIGHT * CELL_SIZE}),
-             "Tower Defense"),
+#include <cmath>
+#include <cstdio>
+#include "profiler.hpp"
+#include "trace_recorder.hpp"
+#include "scenario.hpp"
+#include "memory_tracker.hpp"
+#include "frame_arena.hpp"
+
+GameManager::GameManager(const GameOptions& options)
+    : window(),
       assetManager(),
       uiManager(nullptr),
-      grid(GRID_WIDTH, GRID_HEIGHT),
-      pathfinder(&grid),
-      enemyManager(&grid, &pathfinder, &assetManager),
-      towerManager(&grid, &pathfinder, &enemyManager, &assetManager) {
+      jobSystem(),
+      grid(std::max(options.mapWidth, 2), std::max(options.mapHeight, 2)),
+      pathfinder(&grid, options.jumpPointSearch ? AStarPathfinder::SearchMode::JumpPoint : AStarPathfinder::SearchMode::AStar,
+                 options.bucketQueue ? AStarPathfinder::OpenList::Buckets : AStarPathfinder::OpenList::BinaryHeap),
+      hierarchy(&grid),
+      enemyManager(&grid, &pathfinder, options.headless() ? nullptr : &assetManager),
+      towerManager(&grid, &pathfinder, &enemyManager, options.headless() ? nullptr : &assetManager),
+      FIXED_TIMESTEP(1.0f / std::max(options.tickRate, 1.0f)),
+      options(options) {
+
+    if (!options.tracePath.empty()) {
+        TraceRecorder::instance().enable(options.tracePath, options.traceSeconds);
+        TraceRecorder::instance().setThreadName("Main");
+    }
+
+    // Let the managers spread their per-tick work over the worker pool
+    enemyManager.setJobSystem(&jobSystem);
+    towerManager.setJobSystem(&jobSystem);
+    hierarchy.setJobSystem(&jobSystem);
+    enemyManager.setHierarchicalPathfinder(&hierarchy);
+    towerManager.setHierarchicalPathfinder(&hierarchy);
+    pathService.setBudget(options.pathBudget);
+    enemyManager.setPathService(&pathService);
+
+    // Scenario runs only simulate: no window, textures or UI
+    if (options.headless()) {
+        grid.setStartEnd({0, grid.getHeight() / 2}, {grid.getWidth() - 1, grid.getHeight() / 2});
+        currentState = GameState::PLAYING;
+        return;
+    }
+
+    sf::Vector2f mapArea(VIEW_COLUMNS * CELL_SIZE, VIEW_ROWS * CELL_SIZE);
+    window.create(sf::VideoMode({static_cast<unsigned int>(mapArea.x) + UI_PANEL_WIDTH,
+                                 static_cast<unsigned int>(mapArea.y)}),
+                  "Tower Defense");
 
     // Load all assets
     assetManager.loadAllAssets();
+    MemoryTracker::instance().setTextureBytes(assetManager.estimateTextureBytes());
 
     // Create UI Manager with the loaded font
     uiManager = new UIManager(assetManager.getFont("main_font"));
@@ -36,63 +73,315 @@ GameManager::GameManager()
     }
 
     // Set start/end points for pathfinding
-    grid.setStartEnd({0, GRID_HEIGHT / 2}, {GRID_WIDTH - 1, GRID_HEIGHT / 2});
+    grid.setStartEnd({0, grid.getHeight() / 2}, {grid.getWidth() - 1, grid.getHeight() / 2});
     
     // Recalculate paths now that start/end are set
     enemyManager.recalculatePaths();
 
+    // The camera fills the map area and starts on the spawn point
+    camera.setViewport(sf::FloatRect({0.f, 0.f}, {mapArea.x / (mapArea.x + UI_PANEL_WIDTH), 1.f}));
+    camera.setCenter(cellToWorld(grid.getStart().x, grid.getStart().y));
+    clampCamera();
+
     currentState = GameState::PLAYING;
 }
 
 GameManager::~GameManager() {
+    stopRenderThread();
     delete uiManager;
 }
 
 void GameManager::run() {
+    if (options.renderThread) {
+        startRenderThread();
+    }
+
     while (window.isOpen()) {
-        handleInput();
+        float deltaTime;
+        {
+            ScopedTimer timer("Frame");
+            {
+                // Placements are validated here, so a spike they cause shows up in the trace
+                ScopedTimer inputTimer("Input");
+                handleInput();
+            }
+            if (!window.isOpen()) break;
+
+            deltaTime = clock.restart().asSeconds();
+            updateCamera(deltaTime);
+            if (simulationSpeed == SimulationSpeed::Max) {
+                runMaxSpeedSlice();
+            } else {
+                advanceSimulation(deltaTime * getSpeedMultiplier());
+            }
+
+            presentFrame();
+        }
+
+        // Spikes (e.g. a placement that repaths everything) dump the trace buffer
+        TraceRecorder::instance().reportFrame(deltaTime * 1000.0f);
+        logMemory();
+    }
+
+    stopRenderThread();
+}
+
+// Play a scripted session as fast as possible through the normal update(),
+// then print throughput, tick-time percentiles and peak load.
+bool GameManager::runScenario(const Scenario& scenario) {
+    grid.initialize(scenario.width, scenario.height);
+    grid.setStartEnd(scenario.start, scenario.end);
+    enemyManager.setSeed(scenario.seed);
+    enemyManager.recalculatePaths();
+
+    playerMoney = scenario.money;
+    playerLives = scenario.lives;
+    autoStartWaves = false;
+    changeState(GameState::PLAYING);
+
+    std::vector<float> tickMilliseconds;
+    tickMilliseconds.reserve(scenario.durationTicks);
+    std::size_t nextTower = 0, nextWave = 0;
+    int towersRejected = 0;
+    std::size_t peakEnemies = 0, peakProjectiles = 0;
+    int allocationFreeTicks = 0;
+    long long tickAllocations = 0, peakTickAllocations = 0;
+    int steadyAllocatingTicks = 0, firstSteadyAllocation = -1;
+
+    auto runStart = std::chrono::steady_clock::now();
+    int tick = 0;
+    for (; tick < scenario.durationTicks && currentState == GameState::PLAYING; tick++) {
+        // Input handling is part of the tick's cost (a placement repaths every enemy)
+        auto tickStart = std::chrono::steady_clock::now();
+
+        // Placements go through the same checks (cost, path validation) as a click
+        while (nextTower < scenario.towers.size() && scenario.towers[nextTower].tick <= tick) {
+            const ScenarioTower& tower = scenario.towers[nextTower++];
+            if (!tryPlaceTower(tower.type, tower.cell, tower.mode)) towersRejected++;
+        }
+        while (nextWave < scenario.waves.size() && scenario.waves[nextWave].tick <= tick) {
+            const ScenarioWave& wave = scenario.waves[nextWave++];
+            currentWave++;
+            enemyManager.spawnWave(wave.count, wave.interval);
+        }
 
-        float deltaTime = clock.restart().asSeconds();
-        accumulator += deltaTime;
+        update(FIXED_TIMESTEP);
+        auto tickEnd = std::chrono::steady_clock::now();
+        tickMilliseconds.push_back(std::chrono::duration<float, std::milli>(tickEnd - tickStart).count());
 
-        while (accumulator >= FIXED_TIMESTEP) {
-            if (currentState == GameState::PLAYING)
-                update(FIXED_TIMESTEP);
-            accumulator -= FIXED_TIMESTEP;
+        long long allocations = MemoryTracker::instance().getTickAllocationTotal();
+        tickAllocations += allocations;
+        peakTickAllocations = std::max(peakTickAllocations, allocations);
+        if (allocations == 0) allocationFreeTicks++;
+        if (scenario.steadyFromTick >= 0 && tick >= scenario.steadyFromTick && allocations > 0) {
+            if (steadyAllocatingTicks++ == 0) firstSteadyAllocation = tick;
         }
 
-        render();
+        peakEnemies = std::max(peakEnemies, enemyManager.getEnemies().size());
+        peakProjectiles = std::max(peakProjectiles, towerManager.getProjectileCount());
+    }
+    float wallSeconds = std::chrono::duration<float>(std::chrono::steady_clock::now() - runStart).count();
+
+    std::vector<float> sorted = tickMilliseconds;
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&sorted](float p) {
+        if (sorted.empty()) return 0.0f;
+        return sorted[std::min(sorted.size() - 1, static_cast<std::size_t>(p * sorted.size()))];
+    };
+
+    std::cout << "Scenario: " << scenario.name << "\n"
+              << "  ticks:            " << tick << " / " << scenario.durationTicks
+              << (currentState == GameState::GAME_OVER ? " (game over)" : "") << "\n"
+              << "  ticks/sec:        " << (wallSeconds > 0.0f ? tick / wallSeconds : 0.0f) << "\n"
+              << "  tick p50/p99/max: " << percentile(0.50f) << " / " << percentile(0.99f) << " / "
+              << (sorted.empty() ? 0.0f : sorted.back()) << " ms\n"
+              << "  towers:           " << towerManager.getTowerCount() << " placed, " << towersRejected << " rejected\n"
+              << "  peak enemies:     " << peakEnemies << "\n"
+              << "  peak projectiles: " << peakProjectiles << "\n"
+              << "  lives left:       " << playerLives << "\n"
+              << "  enemy repaths:    " << pathService.getCompletedCount() << ", peak queue "
+              << pathService.getPeakPending() << "\n"
+              << "  path cache:       " << pathfinder.getPathCache().getHits() << " hits, "
+              << pathfinder.getPathCache().getMisses() << " misses\n"
+              << "  heap allocs/tick: " << (tick > 0 ? static_cast<double>(tickAllocations) / tick : 0.0)
+              << " avg, " << peakTickAllocations << " max, " << allocationFreeTicks << " ticks with none\n"
+              << "  peak RSS:         " << getPeakResidentBytes() / (1024 * 1024) << " MB\n"
+              << MemoryTracker::instance().formatReport() << std::flush;
+
+    if (scenario.steadyFromTick < 0) return true;
+    if (steadyAllocatingTicks > 0) {
+        std::cerr << "Steady state check failed: " << steadyAllocatingTicks << " ticks from tick "
+                  << scenario.steadyFromTick << " allocated, the first at tick " << firstSteadyAllocation << std::endl;
+        return false;
     }
+    std::cout << "Steady state check passed: no allocations from tick " << scenario.steadyFromTick << std::endl;
+    return true;
+}
+
+// Append the memory counters to the --memory-log file every few seconds, so
+// growth over a long session can be traced to a subsystem afterwards
+void GameManager::logMemory() {
+    if (options.memoryLogPath.empty() ||
+        memoryLogClock.getElapsedTime().asSeconds() < MEMORY_LOG_INTERVAL) {
+        return;
+    }
+    memoryLogClock.restart();
+
+    if (!MemoryTracker::instance().appendToLog(options.memoryLogPath, sessionClock.getElapsedTime().asSeconds())) {
+        std::cerr << "Could not write memory log " << options.memoryLogPath << std::endl;
+    }
+}
+
+// Run as many fixed steps as the elapsed time calls for, within limits.
+// Without them one long stall makes the next frame run hundreds of steps,
+// which stalls that frame further (the "spiral of death").
+void GameManager::advanceSimulation(float deltaTime) {
+    // Fast-forward scales game time, so the limits scale with it
+    float speed = getSpeedMultiplier();
+    int stepLimit = static_cast<int>(MAX_STEPS_PER_FRAME * speed);
+
+    // A stall (asset hitch, window drag) is clamped rather than replayed
+    if (deltaTime > MAX_FRAME_TIME * speed) {
+        tickStats.ticksDropped += static_cast<unsigned long long>((deltaTime - MAX_FRAME_TIME * speed) / FIXED_TIMESTEP);
+        deltaTime = MAX_FRAME_TIME * speed;
+    }
+    accumulator += deltaTime;
+
+    // Allow only as many steps as fit in the catch-up budget at the
+    // current cost per step
+    int maxSteps = stepLimit;
+    if (averageTickCost > 0.0f) {
+        maxSteps = std::clamp(static_cast<int>(CATCH_UP_BUDGET / averageTickCost), 1, stepLimit);
+    }
+    tickStats.maxStepsPerFrame = maxSteps;
+
+    int steps = 0;
+    while (accumulator >= FIXED_TIMESTEP && steps < maxSteps) {
+        if (currentState == GameState::PLAYING) {
+            auto tickStart = std::chrono::steady_clock::now();
+            update(FIXED_TIMESTEP);
+            lastTickTime = std::chrono::steady_clock::now();
+
+            float tickCost = std::chrono::duration<float>(lastTickTime - tickStart).count();
+            averageTickCost = averageTickCost > 0.0f ? averageTickCost * 0.9f + tickCost * 0.1f : tickCost;
+            tickStats.ticksRun++;
+        }
+        accumulator -= FIXED_TIMESTEP;
+        steps++;
+    }
+    tickStats.lastFrameSteps = steps;
+
+    // Still behind: let game time run slower than wall time instead of
+    // carrying the backlog into the next frame
+    if (accumulator >= FIXED_TIMESTEP) {
+        int skipped = static_cast<int>(accumulator / FIXED_TIMESTEP);
+        tickStats.ticksSlowed += skipped;
+        tickStats.framesBehind++;
+        accumulator -= skipped * FIXED_TIMESTEP;
+    }
+}
+
+// Max speed: step back-to-back for one display refresh, then let a single
+// frame be shown. Intermediate states are never rendered.
+void GameManager::runMaxSpeedSlice() {
+    accumulator = 0.0f;
+
+    sf::Clock sliceClock;
+    int steps = 0;
+    while (currentState == GameState::PLAYING &&
+           sliceClock.getElapsedTime().asSeconds() < DISPLAY_REFRESH_INTERVAL) {
+        update(FIXED_TIMESTEP);
+        tickStats.ticksRun++;
+        steps++;
+    }
+    lastTickTime = std::chrono::steady_clock::now();
+    tickStats.lastFrameSteps = steps;
+
+    // Paused, in a menu or game over: nothing ran, so wait for the next
+    // refresh instead of spinning through input and presenting flat out
+    if (steps == 0) {
+        float remaining = DISPLAY_REFRESH_INTERVAL - presentClock.getElapsedTime().asSeconds();
+        if (remaining > 0.0f) sf::sleep(sf::seconds(remaining));
+    }
+}
+
+void GameManager::presentFrame() {
+    if (renderThread.joinable()) {
+        // Drawing happens on the render thread; hand it the latest tick
+        publishSnapshot();
+        presentClock.restart();
+        if (simulationSpeed != SimulationSpeed::Max) {
+            // Sleep (in wall time) until the next step is due
+            sf::sleep(sf::seconds((FIXED_TIMESTEP - accumulator) / getSpeedMultiplier()));
+        }
+        return;
+    }
+
+    // Fast-forward runs several steps per frame; there is no point drawing
+    // more often than the display can show
+    if (simulationSpeed != SimulationSpeed::Normal &&
+        presentClock.getElapsedTime().asSeconds() < DISPLAY_REFRESH_INTERVAL) {
+        if (simulationSpeed != SimulationSpeed::Max) {
+            // Nothing to draw yet: sleep until the next step or present is due
+            float nextStep = (FIXED_TIMESTEP - accumulator) / getSpeedMultiplier();
+            float nextPresent = DISPLAY_REFRESH_INTERVAL - presentClock.getElapsedTime().asSeconds();
+            sf::sleep(sf::seconds(std::min(nextStep, nextPresent)));
+        }
+        return;
+    }
+    presentClock.restart();
+    render();
 }
 
 void GameManager::handleInput() {
     while (auto event = window.pollEvent()) {
         if (event->is<sf::Event::Closed>()) {
+            stopRenderThread();  // Must not be drawing while the window goes away
             window.close();
         }
 
+        // The cached UI layer may have lost its contents with the old surface
+        if (event->is<sf::Event::Resized>() && uiManager) {
+            uiManager->invalidateStaticLayer();
+        }
+
         if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>()) {
             if (keyPressed->code == sf::Keyboard::Key::Num1) selectedTower = TowerType::Barrier;
             if (keyPressed->code == sf::Keyboard::Key::Num2) selectedTower = TowerType::Gatling;
             if (keyPressed->code == sf::Keyboard::Key::Num3) selectedTower = TowerType::Frost;
             if (keyPressed->code == sf::Keyboard::Key::Num4) selectedTower = TowerType::Artillery;
+            if (keyPressed->code == sf::Keyboard::Key::Tab) {
+                selectedTargetMode = static_cast<TargetMode>((static_cast<int>(selectedTargetMode) + 1) % TARGET_MODE_COUNT);
+            }
             if (keyPressed->code == sf::Keyboard::Key::Space) startNextWave();
             if (keyPressed->code == sf::Keyboard::Key::Escape) togglePause();
+            if (keyPressed->code == sf::Keyboard::Key::F1) setSimulationSpeed(SimulationSpeed::Normal);
+            if (keyPressed->code == sf::Keyboard::Key::F2) setSimulationSpeed(SimulationSpeed::Double);
+            if (keyPressed->code == sf::Keyboard::Key::F3) setSimulationSpeed(SimulationSpeed::Quadruple);
+            if (keyPressed->code == sf::Keyboard::Key::F4) setSimulationSpeed(SimulationSpeed::Max);
+            if (keyPressed->code == sf::Keyboard::Key::P) showProfiler = !showProfiler;
+            if (keyPressed->code == sf::Keyboard::Key::M) showMemory = !showMemory;
+            if (keyPressed->code == sf::Keyboard::Key::T) TraceRecorder::instance().dump();
+        }
+
+        if (const auto* wheel = event->getIf<sf::Event::MouseWheelScrolled>()) {
+            if (wheel->wheel == sf::Mouse::Wheel::Vertical) zoomCamera(wheel->delta, wheel->position);
         }
 
         if (const auto* mousePressed = event->getIf<sf::Event::MouseButtonPressed>()) {
             if (mousePressed->button == sf::Mouse::Button::Left) {
                 sf::Vector2i mousePos = sf::Mouse::getPosition(window);
                 sf::Vector2i gridPos = screenToGrid(mousePos);
-                tryPlaceTower(selectedTower, gridPos);
+                if (grid.getNode(gridPos.x, gridPos.y)) tryPlaceTower(selectedTower, gridPos, selectedTargetMode);
             }
         }
     }
 }
 
 void GameManager::update(float dt) {
-    grid.resetFrostEffects();       // Prevent stacking frost
-    
+    ScopedTimer timer("Tick");
+    FrameArena::resetAll();  // Last tick's scratch data is dead; workers are idle between ticks
+
     const auto& enemies = enemyManager.getEnemies();
     towerManager.update(dt, const_cast<std::vector<std::unique_ptr<Enemy>>&>(enemies));
     
@@ -102,7 +391,7 @@ void GameManager::update(float dt) {
     checkWinLoss();
 
     // Only auto-start next wave if we've actually started playing (currentWave > 0)
-    if (currentWave > 0 && enemyManager.allEnemiesDefeated()) {
+    if (autoStartWaves && currentWave > 0 && enemyManager.allEnemiesDefeated()) {
         waveCompleteTimer += dt;
         if (waveCompleteTimer > 3.0f) {
             startNextWave();
@@ -110,31 +399,148 @@ void GameManager::update(float dt) {
         }
     }
 
-    // Update UI with current game state
-    int selectedTowerCost = TOWER_COSTS[static_cast<int>(selectedTower)];
-    uiManager->update(playerMoney, playerLives, currentWave, selectedTower, selectedTowerCost);
+    MemoryTracker::instance().endTick();
 }
 
 void GameManager::render() {
+    captureSnapshot(frameSnapshot);
+
+    // Blend from the previous tick towards the current one by how far we
+    // are into the next step
+    float alpha = (simulationSpeed == SimulationSpeed::Max) ? 1.0f : accumulator / FIXED_TIMESTEP;
+    drawFrame(frameSnapshot, alpha);
+}
+
+// === Rendering helpers ===
+void GameManager::captureWorld(RenderList& out, const sf::FloatRect& visibleArea) {
+    grid.draw(out, visibleArea);
+    towerManager.draw(out, visibleArea);
+    enemyManager.draw(out, visibleArea);
+}
+
+void GameManager::drawFrame(const RenderSnapshot& snapshot, float alpha) {
+    MemoryScope memory(MemoryTag::Rendering);
     window.clear(sf::Color(50, 50, 50));
 
-    grid.draw(window);
-    towerManager.draw(window);
-    enemyManager.draw(window);
+    {
+        ScopedTimer timer("Present");
+        window.setView(snapshot.camera);
+        snapshot.world.draw(window, alpha);
+
+        if (snapshot.previewInMap) {
+            uiManager->drawTowerPreview(window, snapshot.previewCell, snapshot.previewCanPlace);
+        }
+        window.setView(window.getDefaultView());
+    }
 
     // Draw UI
-    uiManager->draw(window);
-    uiManager->drawInstructions(window);
-    
-    // Draw tower preview
-    sf::Vector2i mousePos = sf::Mouse::getPosition(window);
-    sf::Vector2i gridPos = screenToGrid(mousePos);
-    bool canPlace = !towerManager.isOccupied(gridPos) && canAfford(selectedTower);
-    uiManager->drawTowerPreview(window, gridPos, canPlace);
+    {
+        ScopedTimer timer("UIDraw");
+        uiManager->update(snapshot.money, snapshot.lives, snapshot.wave,
+                          snapshot.selectedTower, snapshot.selectedTowerCost, snapshot.selectedTargetMode);
+        uiManager->draw(window);
+    }
+
+    if (snapshot.showProfiler || snapshot.showMemory) {
+        // Rebuilding the report every frame would cost more than what it measures
+        if (profilerRefreshClock.getElapsedTime().asSeconds() > 0.25f) {
+            profilerRefreshClock.restart();
+
+            std::string report;
+            if (snapshot.showProfiler) {
+                const TickStats& stats = snapshot.tickStats;
+                char tickLine[160];
+                std::snprintf(tickLine, sizeof(tickLine),
+                              "steps/frame %d (limit %d)  run %llu  dropped %llu  slowed %llu\n",
+                              stats.lastFrameSteps, stats.maxStepsPerFrame,
+                              stats.ticksRun, stats.ticksDropped, stats.ticksSlowed);
+                report += tickLine + Profiler::instance().formatReport();
+            }
+            if (snapshot.showMemory) {
+                report += MemoryTracker::instance().formatReport();
+            }
+            uiManager->setProfilerReport(report);
+        }
+        uiManager->drawProfilerOverlay(window);
+    }
 
     window.display();
 }
 
+void GameManager::captureSnapshot(RenderSnapshot& snapshot) {
+    MemoryScope memory(MemoryTag::Rendering);
+    snapshot.world.clear();
+    snapshot.camera = camera;
+    sf::FloatRect visibleArea = getVisibleArea(camera);
+    visibleArea.position -= sf::Vector2f(CULL_MARGIN, CULL_MARGIN);
+    visibleArea.size += sf::Vector2f(2 * CULL_MARGIN, 2 * CULL_MARGIN);
+    captureWorld(snapshot.world, visibleArea);
+    snapshot.tickTime = lastTickTime;
+    snapshot.tickStats = tickStats;
+    snapshot.showProfiler = showProfiler;
+    snapshot.showMemory = showMemory;
+
+    snapshot.money = playerMoney;
+    snapshot.lives = playerLives;
+    snapshot.wave = currentWave;
+    snapshot.selectedTower = selectedTower;
+    snapshot.selectedTowerCost = TOWER_COSTS[static_cast<int>(selectedTower)];
+    snapshot.selectedTargetMode = selectedTargetMode;
+
+    sf::Vector2i mousePos = sf::Mouse::getPosition(window);
+    snapshot.previewCell = screenToGrid(mousePos);
+    snapshot.previewInMap = grid.getNode(snapshot.previewCell.x, snapshot.previewCell.y) != nullptr;
+    snapshot.previewCanPlace = !towerManager.isOccupied(snapshot.previewCell) && canAfford(selectedTower);
+}
+
+void GameManager::publishSnapshot() {
+    captureSnapshot(snapshots.beginWrite());
+    snapshots.publish();
+}
+
+void GameManager::startRenderThread() {
+    if (renderThread.joinable()) return;
+
+    // The GL context can only be active on one thread at a time
+    window.setVerticalSyncEnabled(true);
+    if (!window.setActive(false)) {
+        std::cerr << "Could not release the window context, rendering on the main thread" << std::endl;
+        return;
+    }
+
+    renderThreadRunning = true;
+    renderThread = std::thread(&GameManager::renderLoop, this);
+}
+
+void GameManager::stopRenderThread() {
+    if (!renderThread.joinable()) return;
+
+    renderThreadRunning = false;
+    renderThread.join();
+    (void)window.setActive(true);
+}
+
+void GameManager::renderLoop() {
+    (void)window.setActive(true);
+    TraceRecorder::instance().setThreadName("Render");
+
+    while (renderThreadRunning) {
+        const RenderSnapshot* snapshot = snapshots.acquireLatest();
+        if (!snapshot) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Blend between the last two ticks based on how long ago the newest one finished
+        float sinceTick = std::chrono::duration<float>(std::chrono::steady_clock::now() - snapshot->tickTime).count();
+        float alpha = std::clamp(sinceTick / FIXED_TIMESTEP, 0.0f, 1.0f);
+
+        drawFrame(*snapshot, alpha);  // display() waits for vsync
+    }
+
+    (void)window.setActive(false);
+}
+
 // === Logic Helpers ===
 void GameManager::startNextWave() {
     // Don't start a new wave if enemies are still active or being spawned
@@ -167,12 +573,25 @@ void GameManager::togglePause() {
     changeState(paused ? GameState::PAUSED : GameState::PLAYING);
 }
 
+void GameManager::setSimulationSpeed(SimulationSpeed speed) {
+    simulationSpeed = speed;
+    accumulator = 0.0f;  // Don't replay time banked at the old speed
+}
+
+float GameManager::getSpeedMultiplier() const {
+    switch (simulationSpeed) {
+        case SimulationSpeed::Double:    return 2.0f;
+        case SimulationSpeed::Quadruple: return 4.0f;
+        default:                         return 1.0f;  // Max doesn't use wall time at all
+    }
+}
+
 // === Placement Logic ===
-bool GameManager::tryPlaceTower(TowerType type, sf::Vector2i gridPos) {
+bool GameManager::tryPlaceTower(TowerType type, sf::Vector2i gridPos, TargetMode mode) {
     int cost = TOWER_COSTS[static_cast<int>(type)];
     if (playerMoney < cost) return false;
 
-    if (towerManager.placeTower(type, gridPos)) {
+    if (towerManager.placeTower(type, gridPos, mode)) {
         playerMoney -= cost;
         return true;
     }
@@ -181,16 +600,61 @@ bool GameManager::tryPlaceTower(TowerType type, sf::Vector2i gridPos) {
 
 // === Coordinate Conversion ===
 sf::Vector2i GameManager::screenToGrid(sf::Vector2i mousePos) const {
-    return sf::Vector2i(mousePos.x / CELL_SIZE, mousePos.y / CELL_SIZE);
+    if (mousePos.x < 0 || mousePos.x >= VIEW_COLUMNS * CELL_SIZE) {
+        return {-1, -1};  // Over the UI panel
+    }
+    return worldToCell(window.mapPixelToCoords(mousePos, camera));
+}
+
+// === Camera ===
+void GameManager::updateCamera(float deltaTime) {
+    if (!window.hasFocus()) return;
+
+    sf::Vector2f pan;
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Left))  pan.x -= 1.f;
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Right)) pan.x += 1.f;
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Up))    pan.y -= 1.f;
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Down))  pan.y += 1.f;
+    if (pan == sf::Vector2f()) return;
+
+    // Same on-screen speed at any zoom
+    camera.move(pan * CAMERA_PAN_SPEED * cameraZoom * deltaTime);
+    clampCamera();
+}
+
+void GameManager::zoomCamera(float wheelDelta, sf::Vector2i mousePos) {
+    if (mousePos.x >= VIEW_COLUMNS * CELL_SIZE) return;  // Scrolling over the UI panel
+
+    // Keep the world point under the cursor where it is
+    sf::Vector2f before = window.mapPixelToCoords(mousePos, camera);
+    cameraZoom *= std::pow(0.9f, wheelDelta);
+    clampCamera();
+    sf::Vector2f after = window.mapPixelToCoords(mousePos, camera);
+    camera.move(before - after);
+    clampCamera();
 }
 
-sf::Vector2f GameManager::gridToWorld(sf::Vector2i gridPos) const {
-    return sf::Vector2f(gridPos.x * CELL_SIZE + CELL_SIZE / 2.0f,
-                        gridPos.y * CELL_SIZE + CELL_SIZE / 2.0f);
+// Keep the zoom between close-up and whole-map, and the view over the map
+void GameManager::clampCamera() {
+    sf::Vector2f mapArea(VIEW_COLUMNS * CELL_SIZE, VIEW_ROWS * CELL_SIZE);
+    sf::FloatRect world = grid.getWorldBounds();
+
+    float maxZoom = std::max({1.0f, world.size.x / mapArea.x, world.size.y / mapArea.y});
+    cameraZoom = std::clamp(cameraZoom, MIN_CAMERA_ZOOM, maxZoom);
+    camera.setSize(mapArea * cameraZoom);
+
+    // Center the map on an axis where it is smaller than the view
+    sf::Vector2f half = camera.getSize() / 2.f;
+    sf::Vector2f center = camera.getCenter();
+    center.x = (world.size.x <= camera.getSize().x) ? world.size.x / 2.f
+                                                    : std::clamp(center.x, half.x, world.size.x - half.x);
+    center.y = (world.size.y <= camera.getSize().y) ? world.size.y / 2.f
+                                                    : std::clamp(center.y, half.y, world.size.y - half.y);
+    camera.setCenter(center);
 }
 
-sf::Vector2i GameManager::worldToGrid(sf::Vector2f worldPos) const {
-    return sf::Vector2i(worldPos.x / CELL_SIZE, worldPos.y / CELL_SIZE);
+sf::FloatRect GameManager::getVisibleArea(const sf::View& view) const {
+    return sf::FloatRect(view.getCenter() - view.getSize() / 2.f, view.getSize());
 }
 
 // === Game state handling ===
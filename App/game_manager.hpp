@@ -1,13 +1,23 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <optional>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <string>
 #include "grid.hpp"
 #include "a_star_path_finder.hpp"
+#include "hierarchical_pathfinder.hpp"
+#include "path_service.hpp"
 #include "enemy_manager.hpp"
 #include "tower_manager.hpp"
 #include "asset_manager.hpp"
 #include "ui_manager.hpp"
 #include "tower.hpp"
+#include "job_system.hpp"
+#include "render_list.hpp"
+#include "render_snapshot.hpp"
+#include "grid_units.hpp"
 
 enum class GameState {
     MENU,
@@ -18,6 +28,32 @@ enum class GameState {
     VICTORY
 };
 
+// Launch options, parsed from the command line in main()
+struct GameOptions {
+    bool renderThread = false;  // --render-thread: draw on a dedicated thread from snapshots
+    float tickRate = 60.0f;     // --tick-rate <hz>: simulation steps per second
+    std::string tracePath;      // --trace <file>: capture a Chrome trace-event timeline
+    float traceSeconds = 10.0f; // --trace-seconds <s>: how much history each dump keeps
+    std::string memoryLogPath;  // --memory-log <file>: append per-subsystem memory counters every few seconds
+    int mapWidth = 20;          // --map-size <w>x<h>: grid size in cells (20x15 fits the window at 1x zoom)
+    int mapHeight = 15;
+    bool jumpPointSearch = false; // --jump-point-search: JPS instead of plain A* for cell-level searches
+    bool bucketQueue = false;     // --bucket-queue: Dial's bucket queue instead of the binary heap as the open list
+    float pathBudget = PathService::DEFAULT_BUDGET_MS; // --path-budget <ms>: time per tick for rerouting enemies after a placement
+    std::string scenarioPath;   // --scenario <file>: play a scripted session without a window and print a report
+
+    bool headless() const { return !scenarioPath.empty(); }
+};
+
+struct Scenario;
+
+enum class SimulationSpeed {
+    Normal,     // 1x
+    Double,     // 2x
+    Quadruple,  // 4x
+    Max         // As fast as possible, rendering once per display refresh
+};
+
 class GameManager {
 private:
     // === Core systems ===
@@ -25,20 +61,60 @@ private:
     AssetManager assetManager;
     UIManager* uiManager;  // Pointer because it needs font from AssetManager
     
+    JobSystem jobSystem;  // Worker pool shared by the simulation managers
+
     Grid grid;
     AStarPathfinder pathfinder;
+    HierarchicalPathfinder hierarchy;  // Takes over from pathfinder on large maps
+    PathService pathService;           // Enemy repaths, a few per tick
     EnemyManager enemyManager;
     TowerManager towerManager;
 
     // === Timing ===
     sf::Clock clock;
     float accumulator = 0.0f;
-    const float FIXED_TIMESTEP = 1.0f / 60.0f;
+    const float FIXED_TIMESTEP;  // 1 / GameOptions::tickRate
+    std::chrono::steady_clock::time_point lastTickTime;
+
+    // === Catch-up policy ===
+    static constexpr int MAX_STEPS_PER_FRAME = 8;    // Hard cap on steps in a single frame
+    static constexpr float MAX_FRAME_TIME = 0.25f;   // Longer stalls are clamped to this
+    static constexpr float CATCH_UP_BUDGET = 0.05f;  // Wall time one frame may spend on steps
+    float averageTickCost = 0.0f;                    // Smoothed wall time of one update()
+    TickStats tickStats;
+
+    // === Simulation speed ===
+    static constexpr float DISPLAY_REFRESH_INTERVAL = 1.0f / 60.0f;  // Fast-forward renders at most this often
+    SimulationSpeed simulationSpeed = SimulationSpeed::Normal;
+    sf::Clock presentClock;  // Time since the last rendered/published frame
+
+    // === Camera ===
+    sf::View camera;            // World view, shown in the map area left of the UI panel
+    float cameraZoom = 1.0f;    // World pixels per screen pixel
+    static constexpr float CAMERA_PAN_SPEED = 800.0f;  // Screen pixels per second
+    static constexpr float MIN_CAMERA_ZOOM = 0.5f;
+    static constexpr float CULL_MARGIN = 3 * CELL_SIZE;  // Covers sprites and frost areas that overhang their cell
+
+    // === Rendering ===
+    GameOptions options;
+    RenderSnapshot frameSnapshot;     // Reused capture buffer when rendering on this thread
+    SnapshotBuffer snapshots;         // Simulation -> render thread hand-off
+    std::thread renderThread;
+    std::atomic<bool> renderThreadRunning{false};
+
+    // === Instrumentation ===
+    bool showProfiler = false;      // P toggles the timing overlay
+    bool showMemory = false;        // M toggles the memory overlay
+    sf::Clock profilerRefreshClock;
+    static constexpr float MEMORY_LOG_INTERVAL = 5.0f;
+    sf::Clock sessionClock;
+    sf::Clock memoryLogClock;
 
     // === Game state ===
     GameState currentState = GameState::MENU;
     int currentWave = 0;
     float waveCompleteTimer = 0.0f;
+    bool autoStartWaves = true;  // Scenarios schedule their own waves
     bool paused = false;
 
     // === Player resources ===
@@ -48,40 +124,62 @@ private:
 
     // === Tower selection ===
     TowerType selectedTower = TowerType::Barrier;
+    TargetMode selectedTargetMode = TargetMode::Closest;  // Given to shooting towers as they're placed
 
     // === Window dimensions ===
-    static constexpr int GRID_WIDTH = 20;
-    static constexpr int GRID_HEIGHT = 15;
-    static constexpr int CELL_SIZE = 48;  // Increased for better visibility
+    static constexpr int VIEW_COLUMNS = 20;  // Cells across the map area at 1x zoom
+    static constexpr int VIEW_ROWS = 15;
     static constexpr int UI_PANEL_WIDTH = 280;  // Wider panel for longer text
 
 public:
     // === Constructor / lifecycle ===
-    GameManager();
+    explicit GameManager(const GameOptions& options = GameOptions());
     ~GameManager();
     void run();
+    bool runScenario(const Scenario& scenario);  // Headless: needs GameOptions::scenarioPath set. False if a check failed
+
+    const TickStats& getTickStats() const { return tickStats; }
 
 private:
     // === Core loop ===
+    void advanceSimulation(float deltaTime);
+    void runMaxSpeedSlice();
+    void presentFrame();
+    void logMemory();
     void handleInput();
     void update(float dt);
     void render();
 
+    // === Rendering helpers ===
+    void captureWorld(RenderList& out, const sf::FloatRect& visibleArea);
+    void captureSnapshot(RenderSnapshot& snapshot);
+    void drawFrame(const RenderSnapshot& snapshot, float alpha);
+    void publishSnapshot();
+    void startRenderThread();
+    void stopRenderThread();
+    void renderLoop();
+
+    // === Camera ===
+    void updateCamera(float deltaTime);
+    void zoomCamera(float wheelDelta, sf::Vector2i mousePos);
+    void clampCamera();
+    sf::FloatRect getVisibleArea(const sf::View& view) const;
+
     // === Logic helpers ===
     void startNextWave();
     void checkLivesLost();
     void checkWinLoss();
     void togglePause();
+    void setSimulationSpeed(SimulationSpeed speed);
+    float getSpeedMultiplier() const;
 
     // === Placement / interaction ===
-    bool tryPlaceTower(TowerType type, sf::Vector2i gridPos);
+    bool tryPlaceTower(TowerType type, sf::Vector2i gridPos, TargetMode mode = TargetMode::Closest);
     bool canAfford(TowerType type) const;
     int getTowerCost(TowerType type) const;
 
     // === Coordinate helpers ===
-    sf::Vector2i screenToGrid(sf::Vector2i mousePos) const;
-    sf::Vector2f gridToWorld(sf::Vector2i gridPos) const;
-    sf::Vector2i worldToGrid(sf::Vector2f worldPos) const;
+    sf::Vector2i screenToGrid(sf::Vector2i mousePos) const;  // {-1, -1} over the UI panel
 
     // === Game state handling ===
     void changeState(GameState newState);
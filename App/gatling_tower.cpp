@@ -15,7 +15,12 @@ GatlingTower::GatlingTower(sf::Vector2f pos)
     shape.setPosition(position);
 }
 
-void GatlingTower::update(float deltaTime, std::vector<std::unique_ptr<Enemy>>& enemies) {
+void GatlingTower::acquireTarget(const std::vector<std::unique_ptr<Enemy>>& enemies) {
+    // Only look for a target when we are ready to fire this tick
+    currentTarget = (cooldown > 0) ? nullptr : findTarget(enemies);
+}
+
+void GatlingTower::update(float deltaTime, std::vector<std::unique_ptr<Enemy>>& /*enemies*/) {
     if (cooldown > 0) {
         cooldown -= deltaTime;
         return;
@@ -23,22 +28,8 @@ void GatlingTower::update(float deltaTime, std::vector<std::unique_ptr<Enemy>>&
     
     if (!projectileManager) return; // Safety check
 
-    Enemy* target = nullptr;
-    float minDistance = range * range;
-    
-    for (auto& enemy : enemies) {
-        if (enemy->isDead()) continue;
-        
-        sf::Vector2f enemyPos = enemy->getPosition();
-        float dx = position.x - enemyPos.x;
-        float dy = position.y - enemyPos.y;
-        float distanceSq = dx * dx + dy * dy;
-        
-        if (distanceSq <= minDistance) {
-            minDistance = distanceSq;
-            target = enemy.get();
-        }
-    }
+    Enemy* target = currentTarget;
+    currentTarget = nullptr;
 
     if (target) {
         rotateToward(target->getPosition());
@@ -60,17 +51,17 @@ void GatlingTower::update(float deltaTime, std::vector<std::unique_ptr<Enemy>>&
     }
 }
 
-void GatlingTower::draw(sf::RenderWindow& window) {
+void GatlingTower::draw(RenderList& out) {
     // Draw base first (static)
     if (baseSprite) {
-        window.draw(*baseSprite);
+        out.add(*baseSprite);
     }
     
     // Draw shooter on top (rotating)
     if (shooterSprite) {
-        window.draw(*shooterSprite);
+        out.add(*shooterSprite, {}, getTurn());
     } else {
         // Fallback shape if no textures
-        window.draw(shape);
+        out.add(shape);
     }
 }
\ No newline at end of file
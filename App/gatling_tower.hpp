@@ -12,8 +12,9 @@ private:
 
 public:
     GatlingTower(sf::Vector2f pos);
+    void acquireTarget(const std::vector<std::unique_ptr<Enemy>>& enemies) override;
     void update(float deltaTime, std::vector<std::unique_ptr<Enemy>>& enemies) override;
-    void draw(sf::RenderWindow& window) override;
+    void draw(RenderList& out) override;
     
     void setProjectileManager(ProjectileManager* pm) { projectileManager = pm; }
 
@@ -2,15 +2,18 @@
 #include <cmath>
 #include <algorithm>
 #include <iostream>
+#include "profiler.hpp"
+#include "grid_units.hpp"
 
-Grid::Grid(int w, int h) : gridTexture(nullptr) {
+Grid::Grid(int w, int h)
+    : gridTexture(nullptr), startTexture(nullptr), endTexture(nullptr) {
     initialize(w, h);
 }
 
 void Grid::initialize(int w, int h) {
     width = w;
     height = h;
-    nodes.resize(height, std::vector<Node>(width));
+    nodes.assign(height, std::vector<Node>(width));
 
     for (int y = 0; y < height; y++) {
         for (int x = 0; x < width; x++) {
@@ -19,10 +22,63 @@ void Grid::initialize(int w, int h) {
             nodes[y][x].slowMultiplier = 1.0f;
         }
     }
+
+    chunksX = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    chunksY = (height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    tileChunks.assign(static_cast<std::size_t>(chunksX) * chunksY, nullptr);
+    markAllTilesDirty();
+
+    costChanges.clear();
+    costChangesDropped = 0;
+    layoutVersion++;
+
+    topologyHash = 0;
+    for (const auto& row : nodes) {
+        for (const Node& node : row) topologyHash ^= cellKey(node);
+    }
+}
+
+std::uint64_t Grid::cellKey(const Node& node) const {
+    // Costs are quantized so frost added and taken away again hashes as before
+    std::uint64_t state = node.walkable ? static_cast<std::uint64_t>(std::lround(node.getMovementCost() * 1024.0f)) + 1 : 0;
+    std::uint64_t z = static_cast<std::uint64_t>(node.y * width + node.x) * 0x9E3779B97F4A7C15ull + state;
+
+    // splitmix64 finalizer
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+void Grid::markTileDirty(int x, int y) {
+    if (x < 0 || y < 0 || x >= width || y >= height) return;
+    chunkDirty[(y / CHUNK_SIZE) * chunksX + x / CHUNK_SIZE] = 1;
+}
+
+void Grid::recordCostChange(int x, int y, float oldCost) {
+    // Drop the older half when full; readers that still needed it start over
+    if (costChanges.size() >= MAX_COST_CHANGES) {
+        std::size_t dropped = costChanges.size() / 2;
+        costChanges.erase(costChanges.begin(), costChanges.begin() + static_cast<std::ptrdiff_t>(dropped));
+        costChangesDropped += dropped;
+    }
+    costChanges.push_back({x, y, oldCost});
+}
+
+float Grid::crossingCost(const Node& node) {
+    return node.walkable ? node.getMovementCost() : INFINITY;
+}
+
+void Grid::markAllTilesDirty() {
+    chunkDirty.assign(static_cast<std::size_t>(chunksX) * chunksY, 1);
+}
+
+sf::FloatRect Grid::getWorldBounds() const {
+    return sf::FloatRect({0.f, 0.f}, {width * CELL_SIZE, height * CELL_SIZE});
 }
 
 void Grid::setTexture(sf::Texture& texture) {
     gridTexture = &texture;
+    markAllTilesDirty();
     
     std::cout << "Grid texture set: " << texture.getSize().x << "x" << texture.getSize().y << std::endl;
 }
@@ -43,8 +99,8 @@ Node* Grid::getNode(int x, int y) {
     return nullptr;
 }
 
-std::vector<Node*> Grid::getNeighbors(Node* node) {
-    std::vector<Node*> neighbors;
+void Grid::getNeighbors(Node* node, std::pmr::vector<Node*>& neighbors) {
+    neighbors.clear();
     int x = node->x;
     int y = node->y;
 
@@ -52,8 +108,6 @@ std::vector<Node*> Grid::getNeighbors(Node* node) {
     if (y < height - 1) neighbors.push_back(&nodes[y + 1][x]);
     if (x > 0) neighbors.push_back(&nodes[y][x - 1]);
     if (x < width - 1) neighbors.push_back(&nodes[y][x + 1]);
-
-    return neighbors;
 }
 
 bool Grid::isWalkable(int x, int y) {
@@ -63,34 +117,59 @@ bool Grid::isWalkable(int x, int y) {
 
 void Grid::setObstacle(int x, int y, bool blocked) {
     Node* node = getNode(x, y);
-    if (node) node->walkable = !blocked;
+    if (!node) return;
+
+    float oldCost = crossingCost(*node);
+    topologyHash ^= cellKey(*node);  // Take the old state out...
+    node->walkable = !blocked;
+    refreshSlowMultiplier(*node);  // Blocked tiles never carry a frost slow
+    topologyHash ^= cellKey(*node);  // ...and the new one in
+    markTileDirty(x, y);
+    recordCostChange(x, y, oldCost);
 }
 
 void Grid::setStartEnd(sf::Vector2i start, sf::Vector2i end) {
+    markTileDirty(startCell.x, startCell.y);
+    markTileDirty(endCell.x, endCell.y);
     startCell = start;
     endCell = end;
+    markTileDirty(startCell.x, startCell.y);
+    markTileDirty(endCell.x, endCell.y);
 }
 
-void Grid::applyFrostEffect(int centerX, int centerY, int radius, float slowMultiplier) {
+void Grid::refreshSlowMultiplier(Node& node) {
+    if (node.walkable) {
+        node.slowMultiplier = std::min(1.0f + node.frostContribution, 1.7f);
+    } else {
+        node.slowMultiplier = 1.0f;
+    }
+}
+
+void Grid::addFrostContribution(int centerX, int centerY, int radius, float amount) {
     for (int y = centerY - radius; y <= centerY + radius; y++) {
         for (int x = centerX - radius; x <= centerX + radius; x++) {
             Node* node = getNode(x, y);
-            if (!node || !node->walkable) continue;
+            if (!node) continue;
 
-            if (std::abs(x - centerX) <= radius && std::abs(y - centerY) <= radius) {
-                node->slowMultiplier = std::min(node->slowMultiplier + slowMultiplier, 1.7f);
-            }
+            float oldCost = crossingCost(*node);
+            topologyHash ^= cellKey(*node);
+            node->frostContribution = std::max(node->frostContribution + amount, 0.0f);
+            refreshSlowMultiplier(*node);
+            topologyHash ^= cellKey(*node);
+            markTileDirty(x, y);  // Frost tint changed
+            recordCostChange(x, y, oldCost);
         }
     }
 }
 
-void Grid::resetFrostEffects() {
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            nodes[y][x].slowMultiplier = 1.0f;
-        }
-    }
+void Grid::applyFrostEffect(int centerX, int centerY, int radius, float slowMultiplier) {
+    addFrostContribution(centerX, centerY, radius, slowMultiplier);
+}
+
+void Grid::removeFrostEffect(int centerX, int centerY, int radius, float slowMultiplier) {
+    addFrostContribution(centerX, centerY, radius, -slowMultiplier);
 }
+
 void Grid::resetCosts() {
     for (int y = 0; y < height; y++) {
         for (int x = 0; x < width; x++) {
@@ -99,73 +178,118 @@ void Grid::resetCosts() {
     }
 }
 
-void Grid::draw(sf::RenderWindow& window) {
-    float cellSize = 48.f;
+void Grid::rebuildChunk(int chunkX, int chunkY) {
+    float cellSize = CELL_SIZE;
+    int beginX = chunkX * CHUNK_SIZE, endX = std::min(beginX + CHUNK_SIZE, width);
+    int beginY = chunkY * CHUNK_SIZE, endY = std::min(beginY + CHUNK_SIZE, height);
 
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
+    // Two triangles per tile. Textured tiles cover the whole cell, the
+    // untextured fallback leaves a 1px gap so the grid lines stay visible.
+    auto layer = std::make_shared<TileLayer>();
+    layer->texture = gridTexture;
+    sf::VertexArray& tileVertices = layer->vertices;
+    tileVertices.setPrimitiveType(sf::PrimitiveType::Triangles);
+    tileVertices.resize(static_cast<std::size_t>(endX - beginX) * (endY - beginY) * 6);
+
+    sf::Vector2f texSize(1.f, 1.f);
+    if (gridTexture) {
+        texSize = sf::Vector2f(gridTexture->getSize());
+    }
+    float tileSize = gridTexture ? cellSize : cellSize - 1;
+
+    std::size_t vertex = 0;
+    for (int y = beginY; y < endY; y++) {
+        for (int x = beginX; x < endX; x++) {
             Node& node = nodes[y][x];
             sf::Vector2i currentPos(x, y);
 
+            sf::Color color;
             if (gridTexture) {
-                // Always draw the base grid texture first
-                sf::Sprite gridSprite(*gridTexture);
-                gridSprite.setPosition({x * cellSize, y * cellSize});
-                
-                sf::Vector2u texSize = gridTexture->getSize();
-                float scaleX = cellSize / texSize.x;
-                float scaleY = cellSize / texSize.y;
-                gridSprite.setScale({scaleX, scaleY});
-                
                 // Apply color tint for frost effect
-                if (node.slowMultiplier > 1.0f) {
-                    gridSprite.setColor(sf::Color(100, 180, 255));
-                } else {
-                    gridSprite.setColor(sf::Color::White);
-                }
-                
-                window.draw(gridSprite);
-                
-                // Draw start/end overlay on top if this is a start or end cell
-                if (currentPos == startCell && startTexture) {
-                    sf::Sprite startSprite(*startTexture);
-                    startSprite.setPosition({x * cellSize, y * cellSize});
-                    
-                    sf::Vector2u startTexSize = startTexture->getSize();
-                    float startScaleX = cellSize / startTexSize.x;
-                    float startScaleY = cellSize / startTexSize.y;
-                    startSprite.setScale({startScaleX, startScaleY});
-                    
-                    window.draw(startSprite);
-                } else if (currentPos == endCell && endTexture) {
-                    sf::Sprite endSprite(*endTexture);
-                    endSprite.setPosition({x * cellSize, y * cellSize});
-                    
-                    sf::Vector2u endTexSize = endTexture->getSize();
-                    float endScaleX = cellSize / endTexSize.x;
-                    float endScaleY = cellSize / endTexSize.y;
-                    endSprite.setScale({endScaleX, endScaleY});
-                    
-                    window.draw(endSprite);
-                }
+                color = (node.slowMultiplier > 1.0f) ? sf::Color(100, 180, 255) : sf::Color::White;
+            } else if (!node.walkable) {
+                color = sf::Color::Black;
+            } else if (currentPos == startCell) {
+                color = sf::Color::Green;
+            } else if (currentPos == endCell) {
+                color = sf::Color::Red;
+            } else if (node.slowMultiplier > 1.0f) {
+                color = sf::Color(100, 180, 255);
             } else {
-                // Fallback to rectangle rendering if no texture
-                sf::RectangleShape rect({cellSize - 1, cellSize - 1});
-                
-                if (!node.walkable)
-                    rect.setFillColor(sf::Color::Black);
-                else if (sf::Vector2i(x, y) == startCell)
-                    rect.setFillColor(sf::Color::Green);
-                else if (sf::Vector2i(x, y) == endCell)
-                    rect.setFillColor(sf::Color::Red);
-                else if (node.slowMultiplier > 1.0f)
-                    rect.setFillColor(sf::Color(100, 180, 255)); 
-                else
-                    rect.setFillColor(sf::Color(200, 200, 200));
-
-                rect.setPosition({x * cellSize, y * cellSize});
-                window.draw(rect);
+                color = sf::Color(200, 200, 200);
+            }
+
+            sf::Vector2f topLeft(x * cellSize, y * cellSize);
+            sf::Vector2f corners[4] = {
+                topLeft,
+                {topLeft.x + tileSize, topLeft.y},
+                {topLeft.x, topLeft.y + tileSize},
+                {topLeft.x + tileSize, topLeft.y + tileSize}
+            };
+            sf::Vector2f texCoords[4] = {
+                {0.f, 0.f}, {texSize.x, 0.f}, {0.f, texSize.y}, {texSize.x, texSize.y}
+            };
+            const int order[6] = {0, 1, 2, 2, 1, 3};
+
+            sf::Vertex* quad = &tileVertices[vertex];
+            vertex += 6;
+            for (int i = 0; i < 6; i++) {
+                quad[i].position = corners[order[i]];
+                quad[i].texCoords = texCoords[order[i]];
+                quad[i].color = color;
             }
         }
     }
+
+    std::size_t chunk = static_cast<std::size_t>(chunkY) * chunksX + chunkX;
+    tileChunks[chunk] = layer;
+    chunkDirty[chunk] = 0;
+}
+
+void Grid::draw(RenderList& out, const sf::FloatRect& visibleArea) {
+    ScopedTimer timer("GridDraw");
+    float cellSize = CELL_SIZE;
+
+    // Chunks overlapping the view; dirty ones are rebuilt on first sight
+    float chunkWorldSize = CHUNK_SIZE * cellSize;
+    int firstX = std::max(0, static_cast<int>(std::floor(visibleArea.position.x / chunkWorldSize)));
+    int firstY = std::max(0, static_cast<int>(std::floor(visibleArea.position.y / chunkWorldSize)));
+    int lastX = std::min(chunksX - 1, static_cast<int>(std::floor((visibleArea.position.x + visibleArea.size.x) / chunkWorldSize)));
+    int lastY = std::min(chunksY - 1, static_cast<int>(std::floor((visibleArea.position.y + visibleArea.size.y) / chunkWorldSize)));
+
+    for (int chunkY = firstY; chunkY <= lastY; chunkY++) {
+        for (int chunkX = firstX; chunkX <= lastX; chunkX++) {
+            std::size_t chunk = static_cast<std::size_t>(chunkY) * chunksX + chunkX;
+            if (chunkDirty[chunk]) {
+                rebuildChunk(chunkX, chunkY);
+            }
+            out.add(tileChunks[chunk]);
+        }
+    }
+
+    if (!gridTexture) return;
+
+    // Draw start/end overlays on top of the tile layer
+    if (startTexture && visibleArea.contains(cellToWorld(startCell.x, startCell.y))) {
+        sf::Sprite startSprite(*startTexture);
+        startSprite.setPosition({startCell.x * cellSize, startCell.y * cellSize});
+
+        sf::Vector2u startTexSize = startTexture->getSize();
+        float startScaleX = cellSize / startTexSize.x;
+        float startScaleY = cellSize / startTexSize.y;
+        startSprite.setScale({startScaleX, startScaleY});
+
+        out.add(startSprite);
+    }
+    if (endTexture && visibleArea.contains(cellToWorld(endCell.x, endCell.y))) {
+        sf::Sprite endSprite(*endTexture);
+        endSprite.setPosition({endCell.x * cellSize, endCell.y * cellSize});
+
+        sf::Vector2u endTexSize = endTexture->getSize();
+        float endScaleX = cellSize / endTexSize.x;
+        float endScaleY = cellSize / endTexSize.y;
+        endSprite.setScale({endScaleX, endScaleY});
+
+        out.add(endSprite);
+    }
 }
@@ -1,7 +1,11 @@
 #pragma once
 #include <vector>
 #include <SFML/Graphics.hpp>
+#include <memory>
+#include <memory_resource>
+#include <cstdint>
 #include "node.hpp"
+#include "render_list.hpp"
 
 class Grid {
 private:
@@ -11,6 +15,43 @@ private:
     sf::Texture* startTexture;
     sf::Texture* endTexture;
 
+    // Tile geometry is cached per CHUNK_SIZE x CHUNK_SIZE block of cells, so
+    // a change rebuilds one chunk and drawing skips chunks outside the view.
+    // A rebuild creates a new layer so captured frames keep the old one.
+    static constexpr int CHUNK_SIZE = 32;
+    int chunksX = 0, chunksY = 0;
+    std::vector<std::shared_ptr<const TileLayer>> tileChunks;
+    std::vector<char> chunkDirty;
+
+public:
+    struct CostChange {
+        int x, y;
+        float oldCost;  // crossingCost() before the change
+    };
+    static constexpr std::size_t MAX_COST_CHANGES = 4096;
+
+private:
+    // Every cell whose walkability or movement cost changed, in order and
+    // numbered from 0 since initialize(). Path caches keep the number they
+    // have read up to and catch up from there. Only the newest changes are
+    // kept: a reader that falls behind the oldest one starts over.
+    std::vector<CostChange> costChanges;
+    std::size_t costChangesDropped = 0;  // Number of costChanges[0]
+    int layoutVersion = 0;  // Bumped by initialize(); caches for an older layout start over
+
+    // Zobrist-style hash of every cell's walkability and cost: the XOR of one
+    // key per cell and state, updated as cells change. Equal grids hash
+    // equal however they got there, so undoing a change restores the hash.
+    std::uint64_t topologyHash = 0;
+    std::uint64_t cellKey(const Node& node) const;
+
+    void refreshSlowMultiplier(Node& node);
+    void addFrostContribution(int centerX, int centerY, int radius, float amount);
+    void markTileDirty(int x, int y);
+    void recordCostChange(int x, int y, float oldCost);
+    void markAllTilesDirty();
+    void rebuildChunk(int chunkX, int chunkY);
+
 public:
     sf::Vector2i startCell, endCell;
 
@@ -22,20 +63,30 @@ public:
     void setEndTexture(sf::Texture& texture);
 
     Node* getNode(int x, int y);
-    std::vector<Node*> getNeighbors(Node* node);
+    void getNeighbors(Node* node, std::pmr::vector<Node*>& neighbors);  // Replaces the contents
     bool isWalkable(int x, int y);
     void setObstacle(int x, int y, bool blocked);
     void setStartEnd(sf::Vector2i start, sf::Vector2i end);
 
+    // Frost is a static field: towers add their slow once when placed and
+    // subtract it again when removed, instead of re-applying every tick.
     void applyFrostEffect(int centerX, int centerY, int radius, float slowMultiplier);
-    void resetFrostEffects();
+    void removeFrostEffect(int centerX, int centerY, int radius, float slowMultiplier);
     void resetCosts(); // NEW
 
-    void draw(sf::RenderWindow& window);
+    void draw(RenderList& out, const sf::FloatRect& visibleArea);  // Only chunks overlapping visibleArea
     
     // Getter methods for start and end positions
     sf::Vector2i getStart() const { return startCell; }
     sf::Vector2i getEnd() const { return endCell; }
     int getWidth() const { return width; }
     int getHeight() const { return height; }
+    sf::FloatRect getWorldBounds() const;
+
+    static float crossingCost(const Node& node);  // Infinite when blocked
+    std::size_t getCostChangeCount() const { return costChangesDropped + costChanges.size(); }
+    std::size_t getFirstCostChange() const { return costChangesDropped; }  // Older ones were dropped
+    const CostChange& getCostChange(std::size_t number) const { return costChanges[number - costChangesDropped]; }
+    int getLayoutVersion() const { return layoutVersion; }
+    std::uint64_t getTopologyHash() const { return topologyHash; }
 };
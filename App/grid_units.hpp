@@ -0,0 +1,16 @@
+#pragma once
+#include <SFML/System.hpp>
+#include <cmath>
+
+// Size of one grid cell in world pixels. Simulation, rendering and input
+// all convert between cells and world positions through these helpers.
+constexpr float CELL_SIZE = 48.f;
+
+inline sf::Vector2f cellToWorld(int x, int y) {
+    return {x * CELL_SIZE + CELL_SIZE / 2.f, y * CELL_SIZE + CELL_SIZE / 2.f};
+}
+
+inline sf::Vector2i worldToCell(sf::Vector2f position) {
+    return {static_cast<int>(std::floor(position.x / CELL_SIZE)),
+            static_cast<int>(std::floor(position.y / CELL_SIZE))};
+}
@@ -0,0 +1,442 @@
+#include "hierarchical_pathfinder.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <utility>
+#include "job_system.hpp"
+#include "profiler.hpp"
+#include "memory_tracker.hpp"
+#include "frame_arena.hpp"
+
+namespace {
+    // Runs at least this long get an entrance at each end instead of one in the middle
+    constexpr int LONG_RUN = 6;
+
+    using OpenEntry = std::pair<float, int>;  // (cost, id)
+    using OpenQueue = std::priority_queue<OpenEntry, std::pmr::vector<OpenEntry>, std::greater<OpenEntry>>;
+
+    // Abstract search entry. Equal f breaks towards the smaller heuristic, so
+    // on open maps the search runs straight at the goal instead of widening
+    // across every equally good route.
+    struct RouteEntry {
+        float f, h;
+        int id;
+        bool operator>(const RouteEntry& other) const {
+            return f > other.f || (f == other.f && h > other.h);
+        }
+    };
+    using RouteQueue = std::priority_queue<RouteEntry, std::pmr::vector<RouteEntry>, std::greater<RouteEntry>>;
+}
+
+HierarchicalPathfinder::HierarchicalPathfinder(Grid* grid) : grid(grid) {}
+
+// === Abstraction ===
+
+int HierarchicalPathfinder::clusterOfPortal(int portalId) const {
+    return static_cast<int>(std::upper_bound(portalBase.begin(), portalBase.end(), portalId) - portalBase.begin()) - 1;
+}
+
+void HierarchicalPathfinder::rebuildAll() {
+    ScopedTimer timer("HierarchyBuild");
+    MemoryScope memory(MemoryTag::Pathfinding);
+
+    clustersX = (grid->getWidth() + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+    clustersY = (grid->getHeight() + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+    clusters.assign(static_cast<std::size_t>(clustersX) * clustersY, Cluster{});
+
+    for (int cy = 0; cy < clustersY; cy++) {
+        for (int cx = 0; cx < clustersX; cx++) {
+            Cluster& cluster = clusters[cy * clustersX + cx];
+            cluster.left = cx * CLUSTER_SIZE;
+            cluster.top = cy * CLUSTER_SIZE;
+            cluster.right = std::min(cluster.left + CLUSTER_SIZE, grid->getWidth());
+            cluster.bottom = std::min(cluster.top + CLUSTER_SIZE, grid->getHeight());
+        }
+    }
+
+    // Clusters only read the grid and write themselves, so they build in parallel
+    auto build = [this](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) rebuildCluster(static_cast<int>(i));
+    };
+    auto link = [this](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) linkPartners(static_cast<int>(i));
+    };
+    if (jobSystem) {
+        jobSystem->parallelFor(clusters.size(), 16, build);
+        jobSystem->parallelFor(clusters.size(), 64, link);
+    } else {
+        build(0, clusters.size());
+        link(0, clusters.size());
+    }
+    updatePortalBase();
+
+    layoutVersion = grid->getLayoutVersion();
+    changesRead = grid->getCostChangeCount();
+}
+
+void HierarchicalPathfinder::update() {
+    // A new layout, or changes we hadn't read were dropped from the log
+    if (grid->getLayoutVersion() != layoutVersion || changesRead < grid->getFirstCostChange()) {
+        rebuildAll();
+        return;
+    }
+
+    std::size_t changeCount = grid->getCostChangeCount();
+    if (changesRead == changeCount) return;
+
+    ScopedTimer timer("HierarchyUpdate");
+    MemoryScope memory(MemoryTag::Pathfinding);
+    ArenaScope scratch;
+
+    // A changed cell dirties its own cluster, and the neighbour across any
+    // border it lies on, since the entrances on that border may have moved
+    std::pmr::vector<char> dirty(clusters.size(), 0, scratch.resource());
+    std::pmr::vector<int> dirtyList(scratch.resource());
+    auto markDirty = [&](int x, int y) {
+        int cluster = clusterAt(x, y);
+        if (!dirty[cluster]) {
+            dirty[cluster] = 1;
+            dirtyList.push_back(cluster);
+        }
+    };
+
+    for (std::size_t i = changesRead; i < changeCount; i++) {
+        int x = grid->getCostChange(i).x, y = grid->getCostChange(i).y;
+        markDirty(x, y);
+        if (x % CLUSTER_SIZE == 0 && x > 0) markDirty(x - 1, y);
+        if (x % CLUSTER_SIZE == CLUSTER_SIZE - 1 && x < grid->getWidth() - 1) markDirty(x + 1, y);
+        if (y % CLUSTER_SIZE == 0 && y > 0) markDirty(x, y - 1);
+        if (y % CLUSTER_SIZE == CLUSTER_SIZE - 1 && y < grid->getHeight() - 1) markDirty(x, y + 1);
+    }
+    changesRead = changeCount;
+
+    auto build = [this, &dirtyList](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) rebuildCluster(dirtyList[i]);
+    };
+    if (jobSystem) {
+        jobSystem->parallelFor(dirtyList.size(), 4, build);
+    } else {
+        build(0, dirtyList.size());
+    }
+
+    // Portal indices of rebuilt clusters changed, so their neighbours relink too
+    std::pmr::vector<char> relink(clusters.size(), 0, scratch.resource());
+    for (int cluster : dirtyList) {
+        int cx = cluster % clustersX, cy = cluster / clustersX;
+        relink[cluster] = 1;
+        if (cx > 0) relink[cluster - 1] = 1;
+        if (cx < clustersX - 1) relink[cluster + 1] = 1;
+        if (cy > 0) relink[cluster - clustersX] = 1;
+        if (cy < clustersY - 1) relink[cluster + clustersX] = 1;
+    }
+    for (std::size_t cluster = 0; cluster < relink.size(); cluster++) {
+        if (relink[cluster]) linkPartners(static_cast<int>(cluster));
+    }
+    updatePortalBase();
+}
+
+void HierarchicalPathfinder::addBorderPortals(Cluster& cluster, int side) {
+    // Sides: 0 top, 1 right, 2 bottom, 3 left. Both clusters sharing a border
+    // walk it in the same order, so they agree on where its entrances are.
+    bool horizontal = (side == 0 || side == 2);
+    int length = horizontal ? cluster.right - cluster.left : cluster.bottom - cluster.top;
+
+    auto cellAt = [&](int i, int& x, int& y, int& acrossX, int& acrossY) {
+        switch (side) {
+            case 0: x = cluster.left + i; y = cluster.top; acrossX = x; acrossY = y - 1; break;
+            case 1: x = cluster.right - 1; y = cluster.top + i; acrossX = x + 1; acrossY = y; break;
+            case 2: x = cluster.left + i; y = cluster.bottom - 1; acrossX = x; acrossY = y + 1; break;
+            default: x = cluster.left; y = cluster.top + i; acrossX = x - 1; acrossY = y; break;
+        }
+    };
+    auto addPortal = [&](int i) {
+        Portal portal;
+        cellAt(i, portal.x, portal.y, portal.acrossX, portal.acrossY);
+        cluster.portals.push_back(portal);
+    };
+
+    int runStart = -1;
+    for (int i = 0; i <= length; i++) {
+        bool open = false;
+        if (i < length) {
+            int x, y, acrossX, acrossY;
+            cellAt(i, x, y, acrossX, acrossY);
+            open = grid->isWalkable(x, y) && grid->isWalkable(acrossX, acrossY);  // Off-map counts as blocked
+        }
+
+        if (open && runStart < 0) {
+            runStart = i;
+        } else if (!open && runStart >= 0) {
+            int runLength = i - runStart;
+            if (runLength >= LONG_RUN) {
+                addPortal(runStart);
+                addPortal(i - 1);
+            } else {
+                addPortal(runStart + (runLength - 1) / 2);
+            }
+            runStart = -1;
+        }
+    }
+}
+
+void HierarchicalPathfinder::rebuildCluster(int index) {
+    Cluster& cluster = clusters[index];
+    cluster.portals.clear();
+    for (int side = 0; side < 4; side++) {
+        addBorderPortals(cluster, side);
+    }
+
+    // One search per portal gives its row of the cost table
+    std::size_t count = cluster.portals.size();
+    cluster.costs.assign(count * count, INFINITY);
+
+    ArenaScope scratch;
+    std::pmr::vector<float> costs(scratch.resource());
+    int width = cluster.right - cluster.left;
+    for (std::size_t from = 0; from < count; from++) {
+        searchCluster(cluster, cluster.portals[from].x, cluster.portals[from].y, false, costs);
+        for (std::size_t to = 0; to < count; to++) {
+            const Portal& target = cluster.portals[to];
+            cluster.costs[from * count + to] = costs[(target.y - cluster.top) * width + (target.x - cluster.left)];
+        }
+    }
+}
+
+void HierarchicalPathfinder::linkPartners(int index) {
+    for (Portal& portal : clusters[index].portals) {
+        portal.partnerCluster = clusterAt(portal.acrossX, portal.acrossY);
+        portal.partner = -1;
+
+        const std::vector<Portal>& others = clusters[portal.partnerCluster].portals;
+        for (std::size_t i = 0; i < others.size(); i++) {
+            const Portal& other = others[i];
+            if (other.x == portal.acrossX && other.y == portal.acrossY &&
+                other.acrossX == portal.x && other.acrossY == portal.y) {
+                portal.partner = static_cast<int>(i);
+                break;
+            }
+        }
+    }
+}
+
+void HierarchicalPathfinder::updatePortalBase() {
+    portalBase.resize(clusters.size() + 1);
+    portalBase[0] = 0;
+    for (std::size_t i = 0; i < clusters.size(); i++) {
+        portalBase[i + 1] = portalBase[i] + static_cast<int>(clusters[i].portals.size());
+    }
+}
+
+void HierarchicalPathfinder::searchCluster(const Cluster& cluster, int x, int y, bool reverse,
+                                           std::pmr::vector<float>& costs, std::pmr::vector<int>* parents,
+                                           int stopX, int stopY) const {
+    int width = cluster.right - cluster.left;
+    int height = cluster.bottom - cluster.top;
+    costs.assign(static_cast<std::size_t>(width) * height, INFINITY);
+    if (parents) parents->assign(costs.size(), -1);
+
+    int source = (y - cluster.top) * width + (x - cluster.left);
+    int stop = (stopX >= 0) ? (stopY - cluster.top) * width + (stopX - cluster.left) : -1;
+
+    OpenQueue open(std::greater<OpenEntry>(), std::pmr::vector<OpenEntry>(costs.get_allocator().resource()));
+    costs[source] = 0.f;
+    open.push({0.f, source});
+
+    const int offsets[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+    while (!open.empty()) {
+        auto [cost, local] = open.top();
+        open.pop();
+        if (cost > costs[local]) continue;  // Stale entry
+        if (local == stop) return;
+
+        int cellX = cluster.left + local % width;
+        int cellY = cluster.top + local / width;
+        Node* current = grid->getNode(cellX, cellY);
+
+        for (const auto& offset : offsets) {
+            int nextX = cellX + offset[0], nextY = cellY + offset[1];
+            if (nextX < cluster.left || nextX >= cluster.right || nextY < cluster.top || nextY >= cluster.bottom)
+                continue;
+
+            Node* next = grid->getNode(nextX, nextY);
+            if (!next->walkable) continue;
+
+            // Entering a cell costs that cell's movement cost, as in AStarPathfinder.
+            // Searching backwards, the step leaves `current` towards the source.
+            float newCost = cost + (reverse ? current->getMovementCost() : next->getMovementCost());
+            int nextLocal = (nextY - cluster.top) * width + (nextX - cluster.left);
+            if (newCost < costs[nextLocal]) {
+                costs[nextLocal] = newCost;
+                if (parents) (*parents)[nextLocal] = local;
+                open.push({newCost, nextLocal});
+            }
+        }
+    }
+}
+
+// === Queries ===
+
+bool HierarchicalPathfinder::findRoute(Node* start, Node* end, std::vector<Node*>& waypoints) {
+    ScopedTimer timer("Pathfinding");
+    MemoryScope memory(MemoryTag::Pathfinding);
+    waypoints.clear();
+    if (!start || !end) return false;
+    if (start == end) {
+        waypoints.push_back(end);
+        return true;
+    }
+
+    ArenaScope scratch;
+    const Cluster& startCluster = clusters[clusterAt(start->x, start->y)];
+    const Cluster& endCluster = clusters[clusterAt(end->x, end->y)];
+    int endClusterIndex = clusterAt(end->x, end->y);
+
+    // Hook start and end into the graph with searches inside their clusters
+    std::pmr::vector<float> startCosts(scratch.resource());
+    std::pmr::vector<float> endCosts(scratch.resource());
+    searchCluster(startCluster, start->x, start->y, false, startCosts);
+    searchCluster(endCluster, end->x, end->y, true, endCosts);
+    auto localIndex = [](const Cluster& cluster, int x, int y) {
+        return (y - cluster.top) * (cluster.right - cluster.left) + (x - cluster.left);
+    };
+
+    // Portal ids, then the start and end nodes
+    int portalCount = getPortalCount();
+    int startId = portalCount;
+    int endId = portalCount + 1;
+
+    std::pmr::vector<float> gCosts(portalCount + 2, INFINITY, scratch.resource());
+    std::pmr::vector<int> parents(portalCount + 2, -1, scratch.resource());
+    std::pmr::vector<char> closed(portalCount + 2, 0, scratch.resource());
+    RouteQueue open(std::greater<RouteEntry>(), std::pmr::vector<RouteEntry>(scratch.resource()));
+
+    auto cellOf = [&](int id) -> sf::Vector2i {
+        if (id == startId) return {start->x, start->y};
+        if (id == endId) return {end->x, end->y};
+        int cluster = clusterOfPortal(id);
+        const Portal& portal = clusters[cluster].portals[id - portalBase[cluster]];
+        return {portal.x, portal.y};
+    };
+    auto relax = [&](int from, int to, int x, int y, float cost) {
+        if (cost >= gCosts[to]) return;
+        gCosts[to] = cost;
+        parents[to] = from;
+        float heuristic = static_cast<float>(std::abs(x - end->x) + std::abs(y - end->y));  // Manhattan
+        open.push({cost + heuristic, heuristic, to});
+    };
+
+    gCosts[startId] = 0.f;
+    open.push({0.f, 0.f, startId});
+    while (!open.empty()) {
+        int current = open.top().id;
+        open.pop();
+        if (closed[current]) continue;  // Already expanded through a cheaper entry
+        closed[current] = 1;
+        float g = gCosts[current];
+
+        if (current == endId) {
+            std::size_t length = 0;
+            for (int id = endId; id != startId; id = parents[id]) length++;
+
+            waypoints.resize(length);
+            for (int id = endId; id != startId; id = parents[id]) {
+                sf::Vector2i cell = cellOf(id);
+                waypoints[--length] = grid->getNode(cell.x, cell.y);
+            }
+            return true;
+        }
+
+        if (current == startId) {
+            int base = portalBase[clusterAt(start->x, start->y)];
+            for (std::size_t i = 0; i < startCluster.portals.size(); i++) {
+                const Portal& portal = startCluster.portals[i];
+                float cost = startCosts[localIndex(startCluster, portal.x, portal.y)];
+                if (cost < INFINITY) relax(current, base + static_cast<int>(i), portal.x, portal.y, cost);
+            }
+            if (&startCluster == &endCluster) {
+                float cost = startCosts[localIndex(startCluster, end->x, end->y)];
+                if (cost < INFINITY) relax(current, endId, end->x, end->y, cost);
+            }
+            continue;
+        }
+
+        int clusterIndex = clusterOfPortal(current);
+        const Cluster& cluster = clusters[clusterIndex];
+        int base = portalBase[clusterIndex];
+        int index = current - base;
+        const Portal& portal = cluster.portals[index];
+
+        // Across the border into the neighbouring cluster
+        if (portal.partner >= 0) {
+            Node* across = grid->getNode(portal.acrossX, portal.acrossY);
+            relax(current, portalBase[portal.partnerCluster] + portal.partner, portal.acrossX, portal.acrossY,
+                  g + across->getMovementCost());
+        }
+
+        // To the cluster's other entrances
+        std::size_t count = cluster.portals.size();
+        for (std::size_t i = 0; i < count; i++) {
+            float cost = cluster.costs[index * count + i];
+            if (cost < INFINITY && static_cast<int>(i) != index) {
+                relax(current, base + static_cast<int>(i), cluster.portals[i].x, cluster.portals[i].y, g + cost);
+            }
+        }
+
+        if (clusterIndex == endClusterIndex) {
+            float cost = endCosts[localIndex(cluster, portal.x, portal.y)];
+            if (cost < INFINITY) relax(current, endId, end->x, end->y, g + cost);
+        }
+    }
+
+    return false;
+}
+
+bool HierarchicalPathfinder::refineSegment(Node* from, Node* to, std::vector<Node*>& path) {
+    if (from == to) return true;
+    if (!to->walkable) return false;
+
+    // Neighbours are a border crossing (or a step no detour can beat)
+    if (std::abs(from->x - to->x) + std::abs(from->y - to->y) == 1) {
+        path.push_back(to);
+        return true;
+    }
+
+    int clusterIndex = clusterAt(from->x, from->y);
+    if (clusterAt(to->x, to->y) != clusterIndex) return false;
+
+    MemoryScope memory(MemoryTag::Pathfinding);
+    ArenaScope scratch;
+    const Cluster& cluster = clusters[clusterIndex];
+    std::pmr::vector<float> costs(scratch.resource());
+    std::pmr::vector<int> parents(scratch.resource());
+    searchCluster(cluster, from->x, from->y, false, costs, &parents, to->x, to->y);
+
+    int width = cluster.right - cluster.left;
+    int source = (from->y - cluster.top) * width + (from->x - cluster.left);
+    int target = (to->y - cluster.top) * width + (to->x - cluster.left);
+    if (costs[target] == INFINITY) return false;  // Grid changed since the route was planned
+
+    std::size_t length = 0;
+    for (int local = target; local != source; local = parents[local]) length++;
+
+    std::size_t first = path.size();
+    path.resize(first + length);
+    for (int local = target; local != source; local = parents[local]) {
+        path[first + --length] = grid->getNode(cluster.left + local % width, cluster.top + local / width);
+    }
+    return true;
+}
+
+std::vector<Node*> HierarchicalPathfinder::findPath(Node* start, Node* end) {
+    std::vector<Node*> waypoints;
+    std::vector<Node*> path;
+    if (!findRoute(start, end, waypoints)) return path;
+
+    path.push_back(start);
+    for (Node* waypoint : waypoints) {
+        if (!refineSegment(path.back(), waypoint, path)) return {};
+    }
+    return path;
+}
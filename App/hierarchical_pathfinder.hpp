@@ -0,0 +1,90 @@
+#pragma once
+#include <vector>
+#include <memory_resource>
+#include "grid.hpp"
+
+class JobSystem;
+
+// HPA* over the grid for maps too big to search cell by cell on every
+// placement. The map is split into CLUSTER_SIZE x CLUSTER_SIZE clusters.
+// Wherever two clusters share a run of open border cells there is an
+// entrance, and each cluster stores the cost between every pair of its
+// entrances. A search runs over that small graph, and each cluster crossing
+// is only turned into cells (refineSegment) when an enemy is about to enter
+// it. Paths come out a few percent longer than A*'s.
+//
+// update() catches up on the grid's cost change log and rebuilds only the
+// clusters the changed cells touch.
+class HierarchicalPathfinder {
+public:
+    static constexpr int CLUSTER_SIZE = 16;
+    // Smaller maps are searched cell by cell: A* is cheap there and its paths are exact
+    static constexpr int MIN_GRID_CELLS = 128 * 128;
+
+private:
+    // Entrance cell inside a cluster, paired with the cell across the border
+    struct Portal {
+        int x, y;
+        int acrossX, acrossY;
+        int partnerCluster = -1;  // Cluster and index of the portal on the other side
+        int partner = -1;
+    };
+
+    struct Cluster {
+        int left, top, right, bottom;  // Cell bounds, right/bottom exclusive
+        std::vector<Portal> portals;
+        std::vector<float> costs;      // portals x portals, row = from; INFINITY if unreachable inside the cluster
+    };
+
+    Grid* grid;
+    JobSystem* jobSystem = nullptr;
+
+    int clustersX = 0, clustersY = 0;
+    std::vector<Cluster> clusters;
+    std::vector<int> portalBase;  // Prefix sums of portal counts; portal ids are portalBase[cluster] + index
+
+    int layoutVersion = -1;       // Grid layout the clusters were built for
+    std::size_t changesRead = 0;  // How much of the grid's cost change log is applied
+
+    int clusterAt(int x, int y) const { return (y / CLUSTER_SIZE) * clustersX + x / CLUSTER_SIZE; }
+    int clusterOfPortal(int portalId) const;
+
+    void rebuildAll();
+    void rebuildCluster(int cluster);
+    void addBorderPortals(Cluster& cluster, int side);
+    void linkPartners(int cluster);
+    void updatePortalBase();
+
+    // Cheapest cost from (x, y) to every cell of the cluster without leaving
+    // it, in cluster-local order. With `reverse` the costs are to (x, y).
+    // Stops early once (stopX, stopY) is settled; parents are optional.
+    void searchCluster(const Cluster& cluster, int x, int y, bool reverse,
+                       std::pmr::vector<float>& costs, std::pmr::vector<int>* parents = nullptr,
+                       int stopX = -1, int stopY = -1) const;
+
+public:
+    HierarchicalPathfinder(Grid* grid);
+
+    void setJobSystem(JobSystem* jobs) { jobSystem = jobs; }
+
+    bool isActive() const { return grid->getWidth() * grid->getHeight() >= MIN_GRID_CELLS; }
+
+    // Applies grid changes made since the last call (building everything on
+    // the first call or after Grid::initialize). Cheap when nothing changed
+    void update();
+
+    // Coarse route from start to end: the entrance cells to pass through, then
+    // end itself (start is not included). Uses the thread's FrameArena for
+    // scratch data. Call update() first if the grid has changed.
+    bool findRoute(Node* start, Node* end, std::vector<Node*>& waypoints);
+
+    // Appends the cells after `from` up to and including `to`. The two must be
+    // neighbours or share a cluster, as consecutive route waypoints do
+    bool refineSegment(Node* from, Node* to, std::vector<Node*>& path);
+
+    // Full cell path, refining every segment at once
+    std::vector<Node*> findPath(Node* start, Node* end);
+
+    int getClusterCount() const { return static_cast<int>(clusters.size()); }
+    int getPortalCount() const { return portalBase.empty() ? 0 : portalBase.back(); }
+};
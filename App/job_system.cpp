@@ -0,0 +1,163 @@
+#include "job_system.hpp"
+#include <algorithm>
+#include <string>
+#include "trace_recorder.hpp"
+#include "memory_tracker.hpp"
+
+namespace {
+    // Index of the worker running on this thread, or -1 for non-worker threads
+    thread_local int currentWorkerIndex = -1;
+}
+
+JobSystem::JobSystem(unsigned int threadCount) {
+    if (threadCount == 0) {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    for (unsigned int i = 0; i < threadCount; i++) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (unsigned int i = 0; i < threadCount; i++) {
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void JobSystem::submit(std::function<void()> job) {
+    if (workers.empty()) {
+        job();  // No pool - run inline
+        return;
+    }
+
+    // Workers push onto their own deque, everyone else spreads round-robin
+    std::size_t index = currentWorkerIndex >= 0
+        ? static_cast<std::size_t>(currentWorkerIndex)
+        : nextQueue.fetch_add(1) % queues.size();
+
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->jobs.push_back(std::move(job));
+    }
+    queuedJobs.fetch_add(1);
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);  // Pairs with the wait predicate
+    }
+    wakeCondition.notify_one();
+}
+
+bool JobSystem::popJob(std::size_t queueIndex, std::function<void()>& job) {
+    WorkerQueue& queue = *queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) return false;
+
+    job = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    queuedJobs.fetch_sub(1);
+    return true;
+}
+
+bool JobSystem::stealJob(std::size_t thiefIndex, std::function<void()>& job) {
+    std::size_t count = queues.size();
+    for (std::size_t offset = 1; offset <= count; offset++) {
+        std::size_t victim = (thiefIndex + offset) % count;
+
+        WorkerQueue& queue = *queues[victim];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) continue;
+
+        job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        queuedJobs.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::runPendingJob() {
+    std::function<void()> job;
+    bool found = false;
+
+    if (currentWorkerIndex >= 0) {
+        std::size_t self = static_cast<std::size_t>(currentWorkerIndex);
+        found = popJob(self, job) || stealJob(self, job);
+    } else if (!queues.empty()) {
+        found = stealJob(nextQueue.load() % queues.size(), job);
+    }
+
+    if (found) job();
+    return found;
+}
+
+void JobSystem::workerLoop(std::size_t index) {
+    currentWorkerIndex = static_cast<int>(index);
+    TraceRecorder::instance().setThreadName("Worker " + std::to_string(index + 1));
+
+    while (true) {
+        if (runPendingJob()) continue;
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wakeCondition.wait(lock, [this] { return stopping || queuedJobs.load() > 0; });
+        if (stopping && queuedJobs.load() == 0) return;
+    }
+}
+
+void JobSystem::runParallelFor(std::size_t count, std::size_t grainSize, ChunkFunction fn, const void* context) {
+    if (count == 0) return;
+    grainSize = std::max<std::size_t>(grainSize, 1);
+
+    // Not worth the hand-off for a single chunk
+    if (workers.empty() || count <= grainSize) {
+        fn(context, 0, count);
+        return;
+    }
+
+    // Shared by every chunk. The jobs only capture a pointer to it and their
+    // chunk index, which std::function stores without a heap allocation.
+    struct Batch {
+        ChunkFunction fn;
+        const void* context;
+        std::size_t count;
+        std::size_t grainSize;
+        std::atomic<std::size_t> remaining;
+        MemoryTag memoryTag;  // Charge workers' allocations to the caller's subsystem
+    };
+    Batch batch{fn, context, count, grainSize, {(count + grainSize - 1) / grainSize}, currentMemoryTag()};
+    std::size_t chunkCount = batch.remaining.load();
+
+    // Hand out every chunk but the first, which this thread runs itself
+    for (std::size_t chunk = 1; chunk < chunkCount; chunk++) {
+        submit([&batch, chunk] {
+            TraceScope scope("Job");
+            MemoryScope memory(batch.memoryTag);
+            std::size_t begin = chunk * batch.grainSize;
+            batch.fn(batch.context, begin, std::min(begin + batch.grainSize, batch.count));
+            batch.remaining.fetch_sub(1);
+        });
+    }
+
+    {
+        TraceScope scope("Job");
+        fn(context, 0, std::min(grainSize, count));
+    }
+    batch.remaining.fetch_sub(1);
+
+    // Help with outstanding work instead of blocking
+    while (batch.remaining.load() > 0) {
+        if (!runPendingJob()) {
+            std::this_thread::yield();
+        }
+    }
+}
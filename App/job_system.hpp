@@ -0,0 +1,64 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <cstddef>
+
+// Fixed pool of worker threads with work-stealing job queues.
+// Each worker pops its own jobs from the back of its deque and, once that is
+// empty, steals from the front of the other workers' deques.
+class JobSystem {
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> jobs;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;  // One per worker
+    std::vector<std::thread> workers;
+
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    std::atomic<int> queuedJobs{0};
+    std::atomic<unsigned int> nextQueue{0};
+    bool stopping = false;
+
+    // Type-erased chunk callback that doesn't own (or heap-allocate) the callable
+    using ChunkFunction = void (*)(const void* context, std::size_t begin, std::size_t end);
+
+    void runParallelFor(std::size_t count, std::size_t grainSize, ChunkFunction fn, const void* context);
+
+    bool popJob(std::size_t queueIndex, std::function<void()>& job);
+    bool stealJob(std::size_t thiefIndex, std::function<void()>& job);
+    bool runPendingJob();
+    void workerLoop(std::size_t index);
+
+public:
+    // 0 threads = one worker per hardware thread, minus the main thread
+    explicit JobSystem(unsigned int threadCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void submit(std::function<void()> job);
+
+    // Split [0, count) into chunks of at most grainSize and call fn(begin, end)
+    // for each one. Blocks until every chunk is done; the caller helps out.
+    // fn is called by reference, so capturing lambdas cost no allocation.
+    template <typename Fn>
+    void parallelFor(std::size_t count, std::size_t grainSize, const Fn& fn) {
+        runParallelFor(count, grainSize,
+                       [](const void* context, std::size_t begin, std::size_t end) {
+                           (*static_cast<const Fn*>(context))(begin, end);
+                       },
+                       &fn);
+    }
+
+    unsigned int getWorkerCount() const { return static_cast<unsigned int>(workers.size()); }
+};
@@ -1,10 +1,52 @@
 #include "game_manager.hpp"
 #include "main_menu.hpp"
 #include "asset_manager.hpp"
+#include "scenario.hpp"
 #include <iostream>
+#include <string>
+#include <cstdio>
 
-int main() {
+int main(int argc, char* argv[]) {
     try {
+        // Parse launch options
+        GameOptions options;
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "--render-thread") {
+                options.renderThread = true;
+            } else if (arg == "--tick-rate" && i + 1 < argc) {
+                options.tickRate = std::stof(argv[++i]);
+            } else if (arg == "--trace" && i + 1 < argc) {
+                options.tracePath = argv[++i];
+            } else if (arg == "--trace-seconds" && i + 1 < argc) {
+                options.traceSeconds = std::stof(argv[++i]);
+            } else if (arg == "--memory-log" && i + 1 < argc) {
+                options.memoryLogPath = argv[++i];
+            } else if (arg == "--map-size" && i + 1 < argc) {
+                if (std::sscanf(argv[++i], "%dx%d", &options.mapWidth, &options.mapHeight) != 2) {
+                    std::cerr << "--map-size expects <width>x<height>, e.g. 512x512" << std::endl;
+                    return 1;
+                }
+            } else if (arg == "--jump-point-search") {
+                options.jumpPointSearch = true;
+            } else if (arg == "--bucket-queue") {
+                options.bucketQueue = true;
+            } else if (arg == "--path-budget" && i + 1 < argc) {
+                options.pathBudget = std::stof(argv[++i]);
+            } else if (arg == "--scenario" && i + 1 < argc) {
+                options.scenarioPath = argv[++i];
+            } else {
+                std::cerr << "Unknown option: " << arg << std::endl;
+            }
+        }
+
+        // Scripted benchmark run: no menu, no window
+        if (options.headless()) {
+            Scenario scenario = loadScenario(options.scenarioPath);
+            GameManager game(options);
+            return game.runScenario(scenario) ? 0 : 1;
+        }
+
         // Create window for main menu
         sf::RenderWindow window(sf::VideoMode({1248, 720}), "Tower Defense");
         
@@ -40,7 +82,7 @@ int main() {
         if (startGame) {
             window.close();
             
-            GameManager game;
+            GameManager game(options);
             game.run();
         }
     }
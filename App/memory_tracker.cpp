@@ -0,0 +1,176 @@
+#include "memory_tracker.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>          // _msize
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>   // malloc_size
+#else
+#include <malloc.h>          // malloc_usable_size
+#endif
+
+namespace {
+
+MemoryTracker tracker;  // Constant-initialized, so usable by allocations made before main()
+thread_local MemoryTag currentTag = MemoryTag::Untracked;
+
+// Blocks are plain malloc blocks with nothing added, so a block allocated by
+// another module (the SFML DLLs have their own operator new) can still be
+// freed here, and ours there. Sizes come from the allocator itself.
+std::size_t blockSize(void* pointer) {
+#if defined(_WIN32)
+    return _msize(pointer);
+#elif defined(__APPLE__)
+    return malloc_size(pointer);
+#else
+    return malloc_usable_size(pointer);
+#endif
+}
+
+void* trackedAllocate(std::size_t size) {
+    void* block;
+    while (!(block = std::malloc(size == 0 ? 1 : size))) {
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) return nullptr;
+        handler();
+    }
+
+    tracker.recordAllocation(currentTag, blockSize(block));
+    return block;
+}
+
+void trackedFree(void* pointer) {
+    if (!pointer) return;
+
+    tracker.recordFree(currentTag, blockSize(pointer));
+    std::free(pointer);
+}
+
+}  // namespace
+
+// === Global allocation hooks ===
+void* operator new(std::size_t size) {
+    void* pointer = trackedAllocate(size);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](std::size_t size) {
+    void* pointer = trackedAllocate(size);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return trackedAllocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return trackedAllocate(size); }
+
+void operator delete(void* pointer) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer) noexcept { trackedFree(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { trackedFree(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { trackedFree(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { trackedFree(pointer); }
+
+// === MemoryTracker ===
+MemoryTracker& MemoryTracker::instance() {
+    return tracker;
+}
+
+const char* MemoryTracker::tagName(MemoryTag tag) {
+    switch (tag) {
+        case MemoryTag::Untracked:   return "Other";
+        case MemoryTag::Enemies:     return "Enemies";
+        case MemoryTag::Projectiles: return "Projectiles";
+        case MemoryTag::Towers:      return "Towers";
+        case MemoryTag::Pathfinding: return "Pathfinding";
+        case MemoryTag::Rendering:   return "Rendering";
+        case MemoryTag::UI:          return "UI";
+        case MemoryTag::Assets:      return "Assets";
+        default:                     return "?";
+    }
+}
+
+void MemoryTracker::recordAllocation(MemoryTag tag, std::size_t bytes) {
+    Counters& c = counters[static_cast<int>(tag)];
+    c.liveBytes.fetch_add(static_cast<long long>(bytes), std::memory_order_relaxed);
+    c.liveAllocations.fetch_add(1, std::memory_order_relaxed);
+    c.tickBytes.fetch_add(static_cast<long long>(bytes), std::memory_order_relaxed);
+    c.tickAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MemoryTracker::recordFree(MemoryTag tag, std::size_t bytes) {
+    Counters& c = counters[static_cast<int>(tag)];
+    c.liveBytes.fetch_sub(static_cast<long long>(bytes), std::memory_order_relaxed);
+    c.liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void MemoryTracker::endTick() {
+    for (Counters& c : counters) {
+        c.lastTickAllocations = c.tickAllocations.exchange(0, std::memory_order_relaxed);
+        c.lastTickBytes = c.tickBytes.exchange(0, std::memory_order_relaxed);
+    }
+}
+
+MemoryTracker::TagStats MemoryTracker::getStats(MemoryTag tag) const {
+    const Counters& c = counters[static_cast<int>(tag)];
+    return {tagName(tag), c.liveBytes.load(), c.liveAllocations.load(),
+            c.lastTickAllocations.load(), c.lastTickBytes.load()};
+}
+
+long long MemoryTracker::getTickAllocationTotal() const {
+    long long total = 0;
+    for (const Counters& c : counters) {
+        total += c.lastTickAllocations.load();
+    }
+    return total;
+}
+
+std::string MemoryTracker::formatReport() const {
+    std::string report = "memory        live KB  blocks  allocs/tick  KB/tick\n";
+    char line[128];
+    for (int i = 0; i < TAG_COUNT; i++) {
+        TagStats s = getStats(static_cast<MemoryTag>(i));
+        std::snprintf(line, sizeof(line), "%-12s %8.1f %7lld %12lld %8.1f\n",
+                      s.name, s.liveBytes / 1024.0, s.liveAllocations, s.tickAllocations, s.tickBytes / 1024.0);
+        report += line;
+    }
+    std::snprintf(line, sizeof(line), "%-12s %8.1f  (video memory, estimated)\n",
+                  "Textures", textureBytes.load() / 1024.0);
+    report += line;
+    return report;
+}
+
+bool MemoryTracker::appendToLog(const std::string& path, float sessionSeconds) const {
+    std::FILE* file = std::fopen(path.c_str(), "a");
+    if (!file) return false;
+
+    // Header only for a new, empty file
+    std::fseek(file, 0, SEEK_END);
+    if (std::ftell(file) == 0) {
+        std::fprintf(file, "seconds,tag,live_bytes,live_allocations,tick_allocations,tick_bytes\n");
+    }
+    for (int i = 0; i < TAG_COUNT; i++) {
+        TagStats s = getStats(static_cast<MemoryTag>(i));
+        std::fprintf(file, "%.1f,%s,%lld,%lld,%lld,%lld\n", sessionSeconds, s.name,
+                     s.liveBytes, s.liveAllocations, s.tickAllocations, s.tickBytes);
+    }
+    std::fprintf(file, "%.1f,Textures,%zu,0,0,0\n", sessionSeconds, textureBytes.load());
+    std::fclose(file);
+    return true;
+}
+
+// === MemoryScope ===
+MemoryScope::MemoryScope(MemoryTag tag) : previous(currentTag) {
+    currentTag = tag;
+}
+
+MemoryScope::~MemoryScope() {
+    currentTag = previous;
+}
+
+MemoryTag currentMemoryTag() {
+    return currentTag;
+}
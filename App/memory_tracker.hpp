@@ -0,0 +1,83 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+// Subsystem an allocation is charged to: the calling thread's current tag
+// (see MemoryScope). Blocks carry no tag of their own, so a delete is charged
+// to the tag current where it runs. Managers free what they allocate inside
+// their own scope, so per-tag live counts hold up; memory handed between
+// subsystems shows up as growth in one tag and shrinkage in another.
+enum class MemoryTag {
+    Untracked,
+    Enemies,
+    Projectiles,
+    Towers,
+    Pathfinding,
+    Rendering,
+    UI,
+    Assets,
+    Count
+};
+
+// Live and per-tick allocation counters for every tag. Safe to update from
+// any thread; the hooks themselves never allocate.
+class MemoryTracker {
+public:
+    struct TagStats {
+        const char* name;
+        long long liveBytes;
+        long long liveAllocations;
+        long long tickAllocations;  // During the last completed tick
+        long long tickBytes;
+    };
+
+private:
+    static constexpr int TAG_COUNT = static_cast<int>(MemoryTag::Count);
+
+    struct Counters {
+        std::atomic<long long> liveBytes{0};
+        std::atomic<long long> liveAllocations{0};
+        std::atomic<long long> tickAllocations{0};  // Running, since the last endTick()
+        std::atomic<long long> tickBytes{0};
+        std::atomic<long long> lastTickAllocations{0};
+        std::atomic<long long> lastTickBytes{0};
+    };
+
+    Counters counters[TAG_COUNT];
+    std::atomic<std::size_t> textureBytes{0};
+
+public:
+    constexpr MemoryTracker() = default;
+
+    static MemoryTracker& instance();
+    static const char* tagName(MemoryTag tag);
+
+    void recordAllocation(MemoryTag tag, std::size_t bytes);
+    void recordFree(MemoryTag tag, std::size_t bytes);
+    void endTick();  // Publish this tick's counts and start the next
+
+    // Textures live in video memory, so they are estimated (width x height x 4)
+    // rather than counted by the allocation hooks
+    void setTextureBytes(std::size_t bytes) { textureBytes = bytes; }
+
+    TagStats getStats(MemoryTag tag) const;
+    long long getTickAllocationTotal() const;  // All tags, last completed tick
+    std::string formatReport() const;                                     // For the overlay
+    bool appendToLog(const std::string& path, float sessionSeconds) const; // CSV, one row per tag
+};
+
+// Charges allocations made by this thread to `tag` for the scope's lifetime
+class MemoryScope {
+private:
+    MemoryTag previous;
+
+public:
+    explicit MemoryScope(MemoryTag tag);
+    ~MemoryScope();
+
+    MemoryScope(const MemoryScope&) = delete;
+    MemoryScope& operator=(const MemoryScope&) = delete;
+};
+
+MemoryTag currentMemoryTag();
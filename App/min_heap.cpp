@@ -1,12 +1,14 @@
 #include "min_heap.hpp"
 #include <algorithm>
 
+bool MinHeap::isBefore(const Entry& a, const Entry& b) {
+    return a.fCost < b.fCost || (a.fCost == b.fCost && a.hCost < b.hCost);
+}
+
 void MinHeap::heapifyUp(int index) {
     while (index > 0) {
         int parent = (index - 1) / 2;
-        if (heap[index]->getFCost() < heap[parent]->getFCost() ||
-           (heap[index]->getFCost() == heap[parent]->getFCost() &&
-            heap[index]->hCost < heap[parent]->hCost)) {
+        if (isBefore(heap[index], heap[parent])) {
             std::swap(heap[index], heap[parent]);
             index = parent;
         } else break;
@@ -20,17 +22,11 @@ void MinHeap::heapifyDown(int index) {
         int right = 2 * index + 2;
         int smallest = index;
 
-        if (left < size &&
-           (heap[left]->getFCost() < heap[smallest]->getFCost() ||
-           (heap[left]->getFCost() == heap[smallest]->getFCost() &&
-            heap[left]->hCost < heap[smallest]->hCost))) {
+        if (left < size && isBefore(heap[left], heap[smallest])) {
             smallest = left;
         }
 
-        if (right < size &&
-           (heap[right]->getFCost() < heap[smallest]->getFCost() ||
-           (heap[right]->getFCost() == heap[smallest]->getFCost() &&
-            heap[right]->hCost < heap[smallest]->hCost))) {
+        if (right < size && isBefore(heap[right], heap[smallest])) {
             smallest = right;
         }
 
@@ -42,14 +38,14 @@ void MinHeap::heapifyDown(int index) {
 }
 
 void MinHeap::push(Node* node) {
-    heap.push_back(node);
+    heap.push_back({node->getFCost(), node->hCost, node});
     heapifyUp((int)heap.size() - 1);
 }
 
 Node* MinHeap::pop() {
     if (heap.empty()) return nullptr;
 
-    Node* top = heap.front();
+    Node* top = heap.front().node;
     heap[0] = heap.back();
     heap.pop_back();
     if (!heap.empty()) heapifyDown(0);
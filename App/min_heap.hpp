@@ -2,10 +2,20 @@
 #include <vector>
 #include "node.hpp"
 
+// Open set ordered by fCost, ties broken towards the smaller hCost. Keys are
+// copied in at push time: a node pushed again with a lower cost leaves its
+// old entry behind, and that entry must keep its old key or it would sit
+// out of order and bury cheaper nodes beneath it.
 class MinHeap {
 private:
-    std::vector<Node*> heap;
+    struct Entry {
+        float fCost;
+        float hCost;
+        Node* node;
+    };
+    std::vector<Entry> heap;
 
+    static bool isBefore(const Entry& a, const Entry& b);
     void heapifyUp(int index);
     void heapifyDown(int index);
 
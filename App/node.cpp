@@ -9,7 +9,10 @@ Node::Node(int x, int y, bool walkable)
       hCost(0),
       baseCost(1.0f),
       slowMultiplier(1.0f),
-      parent(nullptr) {}
+      frostContribution(0.0f),
+      parent(nullptr),
+      closed(false),
+      searchId(0) {}
 
 // fCost = gCost + hCost
 float Node::getFCost() const {
@@ -31,4 +34,5 @@ void Node::resetCosts() {
     gCost = 0;
     hCost = 0;
     parent = nullptr;
+    closed = false;
 }
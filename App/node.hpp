@@ -10,7 +10,10 @@ public:
     float hCost;              // Heuristic distance to end node
     float baseCost;           // Default traversal cost (usually 1.0f)
     float slowMultiplier;     // Additional movement penalty (used for Frost effect)
+    float frostContribution;  // Summed slow from every Frost Tower covering this tile
     Node* parent;             // Pointer to parent node in path reconstruction
+    bool closed;              // Already expanded by the current search
+    unsigned int searchId;    // Search that last wrote gCost/hCost/parent/closed; older values are stale
 
     Node(int x = 0, int y = 0, bool walkable = true);
 
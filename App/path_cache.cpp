@@ -0,0 +1,42 @@
+#include "path_cache.hpp"
+#include <functional>
+
+std::size_t PathCache::KeyHash::operator()(const Key& key) const {
+    std::size_t h = std::hash<const void*>()(key.start);
+    h = h * 31 + std::hash<const void*>()(key.end);
+    return h ^ static_cast<std::size_t>(key.gridHash);
+}
+
+const std::vector<Node*>* PathCache::find(const Node* start, const Node* end, int layout, std::uint64_t gridHash) {
+    if (layout != layoutVersion) {
+        entries.clear();
+        layoutVersion = layout;
+    }
+
+    auto it = entries.find({start, end, gridHash});
+    if (it == entries.end()) {
+        misses++;
+        return nullptr;
+    }
+    hits++;
+    return &it->second;
+}
+
+void PathCache::store(const Node* start, const Node* end, std::uint64_t gridHash, const std::pmr::vector<Node*>& path) {
+    if (entries.size() >= MAX_ENTRIES) evict(gridHash);
+    entries[{start, end, gridHash}].assign(path.begin(), path.end());
+}
+
+// Entries for other grid states go first; they only come back if the grid is
+// changed back. If that frees nothing, start over
+void PathCache::evict(std::uint64_t currentHash) {
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->first.gridHash != currentHash) it = entries.erase(it);
+        else ++it;
+    }
+    if (entries.size() >= MAX_ENTRIES) entries.clear();
+}
+
+void PathCache::clear() {
+    entries.clear();
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <vector>
+#include <memory_resource>
+#include <unordered_map>
+#include <cstdint>
+#include "node.hpp"
+
+// Finished searches keyed by (start cell, end cell, Grid::getTopologyHash()).
+// A repath burst asks the same questions over and over: the placement check
+// and the new spawn path are the same query, and enemies standing in the
+// same cell all ask for the same path. Because the hash only depends on the
+// cells' current state, undoing a change (a rejected placement, a removed
+// frost tower) makes the old entries valid again.
+//
+// "No path" is cached too, as an empty path. Node pointers die with the
+// grid's nodes, so everything is dropped when the grid layout changes.
+class PathCache {
+public:
+    static constexpr std::size_t MAX_ENTRIES = 1024;
+
+private:
+    struct Key {
+        const Node* start;
+        const Node* end;
+        std::uint64_t gridHash;
+        bool operator==(const Key& other) const {
+            return start == other.start && end == other.end && gridHash == other.gridHash;
+        }
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    std::unordered_map<Key, std::vector<Node*>, KeyHash> entries;
+    int layoutVersion = -1;
+
+    // Stats
+    unsigned long long hits = 0;
+    unsigned long long misses = 0;
+
+    void evict(std::uint64_t currentHash);
+
+public:
+    // Cached path, or null on a miss. Drops everything first if the layout changed
+    const std::vector<Node*>* find(const Node* start, const Node* end, int layout, std::uint64_t gridHash);
+    void store(const Node* start, const Node* end, std::uint64_t gridHash, const std::pmr::vector<Node*>& path);
+    void clear();
+
+    std::size_t size() const { return entries.size(); }
+    unsigned long long getHits() const { return hits; }
+    unsigned long long getMisses() const { return misses; }
+};
@@ -0,0 +1,40 @@
+#include "path_service.hpp"
+#include "profiler.hpp"
+#include <chrono>
+#include <algorithm>
+
+void PathService::setHandlers(Planner plan, Delivery deliver) {
+    planner = std::move(plan);
+    delivery = std::move(deliver);
+}
+
+void PathService::request(int id) {
+    if (!queued.insert(id).second) return;  // Already waiting
+    queue.push_back(id);
+    peakPending = std::max(peakPending, queue.size());
+}
+
+void PathService::cancelAll() {
+    queue.clear();
+    queued.clear();
+}
+
+void PathService::update() {
+    lastTickServed = 0;
+    if (queue.empty() || !planner) return;
+
+    ScopedTimer timer("PathService");
+    auto start = std::chrono::steady_clock::now();
+    do {
+        int id = queue.front();
+        queue.pop_front();
+        queued.erase(id);
+
+        if (planner(id, pathBuffer, waypointBuffer) && delivery) {
+            delivery(id, pathBuffer, waypointBuffer);
+        }
+        completed++;
+        lastTickServed++;
+    } while (!queue.empty() &&
+             std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() < budgetMilliseconds);
+}
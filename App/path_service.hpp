@@ -0,0 +1,58 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <unordered_set>
+#include <functional>
+#include "node.hpp"
+
+// Queue of replan requests, worked off a few at a time within a per-tick
+// time budget so a placement that reroutes hundreds of enemies doesn't
+// freeze the frame. Requesters keep their old path until their result is
+// delivered.
+//
+// Requests are by ID and deduplicated: asking again while one is queued
+// keeps its place in line. The search runs when the request is served, so
+// it starts from where the requester is by then and sees the latest grid.
+// Everything runs on the simulation thread, between grid changes.
+class PathService {
+public:
+    // Plans a path for `id`; false if it is gone or has no route
+    using Planner = std::function<bool(int id, std::vector<Node*>& path, std::vector<Node*>& waypoints)>;
+    // Hands a finished path to its requester
+    using Delivery = std::function<void(int id, const std::vector<Node*>& path, const std::vector<Node*>& waypoints)>;
+
+    static constexpr float DEFAULT_BUDGET_MS = 2.0f;
+
+private:
+    Planner planner;
+    Delivery delivery;
+    float budgetMilliseconds = DEFAULT_BUDGET_MS;
+
+    std::deque<int> queue;
+    std::unordered_set<int> queued;
+
+    std::vector<Node*> pathBuffer;      // Reused between requests
+    std::vector<Node*> waypointBuffer;
+
+    // Stats
+    unsigned long long completed = 0;
+    std::size_t peakPending = 0;
+    int lastTickServed = 0;
+
+public:
+    void setHandlers(Planner plan, Delivery deliver);
+    void setBudget(float milliseconds) { budgetMilliseconds = milliseconds; }
+    float getBudget() const { return budgetMilliseconds; }
+
+    void request(int id);
+    void cancelAll();
+
+    // Serves queued requests until the budget is spent. At least one is
+    // served per call, so the queue drains even with a tiny budget
+    void update();
+
+    std::size_t getPendingCount() const { return queue.size(); }
+    std::size_t getPeakPending() const { return peakPending; }
+    unsigned long long getCompletedCount() const { return completed; }
+    int getLastTickServed() const { return lastTickServed; }
+};
@@ -0,0 +1,84 @@
+#include "profiler.hpp"
+#include "trace_recorder.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+void Profiler::record(const char* section, float milliseconds) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = std::find_if(sections.begin(), sections.end(), [section](const Section& s) {
+        return s.name == section || std::strcmp(s.name, section) == 0;
+    });
+    if (it == sections.end()) {
+        sections.push_back({section, {}, 0, 0.f});
+        it = sections.end() - 1;
+        it->samples.reserve(WINDOW_SIZE);
+    }
+
+    if (it->samples.size() < WINDOW_SIZE) {
+        it->samples.push_back(milliseconds);
+    } else {
+        it->samples[it->next] = milliseconds;
+    }
+    it->next = (it->next + 1) % WINDOW_SIZE;
+    it->last = milliseconds;
+}
+
+std::vector<Profiler::SectionStats> Profiler::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::vector<SectionStats> stats;
+    std::vector<float> sorted;
+    for (const Section& section : sections) {
+        if (section.samples.empty()) continue;
+
+        sorted = section.samples;
+        std::sort(sorted.begin(), sorted.end());
+        auto percentile = [&sorted](float p) {
+            std::size_t index = static_cast<std::size_t>(p * (sorted.size() - 1));
+            return sorted[index];
+        };
+
+        SectionStats s;
+        s.name = section.name;
+        s.p50 = percentile(0.50f);
+        s.p95 = percentile(0.95f);
+        s.p99 = percentile(0.99f);
+        s.max = sorted.back();
+        s.last = section.last;
+        stats.push_back(s);
+    }
+    return stats;
+}
+
+std::string Profiler::formatReport() const {
+    std::string report = "section        p50    p95    p99    max (ms)\n";
+    char line[128];
+    for (const SectionStats& s : getStats()) {
+        std::snprintf(line, sizeof(line), "%-12s %6.2f %6.2f %6.2f %6.2f\n",
+                      s.name.c_str(), s.p50, s.p95, s.p99, s.max);
+        report += line;
+    }
+    return report;
+}
+
+void Profiler::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    sections.clear();
+}
+
+ScopedTimer::ScopedTimer(const char* section)
+    : section(section), start(std::chrono::steady_clock::now()) {}
+
+ScopedTimer::~ScopedTimer() {
+    auto end = std::chrono::steady_clock::now();
+    float elapsed = std::chrono::duration<float, std::milli>(end - start).count();
+    Profiler::instance().record(section, elapsed);
+    TraceRecorder::instance().record(section, start, end);
+}
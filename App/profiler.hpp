@@ -0,0 +1,67 @@
+#pragma once
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Counters describing how the fixed-step loop kept up with wall time
+struct TickStats {
+    unsigned long long ticksRun = 0;       // Simulation steps executed
+    unsigned long long ticksDropped = 0;   // Steps discarded because a stall exceeded GameManager::MAX_FRAME_TIME
+    unsigned long long ticksSlowed = 0;    // Steps skipped by time dilation when catch-up fell behind
+    unsigned long long framesBehind = 0;   // Frames that hit the per-frame step limit
+    int lastFrameSteps = 0;                // Steps run during the most recent frame
+    int maxStepsPerFrame = 0;              // Current adaptive step limit
+};
+
+// Collects per-section timing samples in fixed-size rolling windows so the
+// overlay can show recent percentiles. Safe to record from any thread.
+class Profiler {
+public:
+    struct SectionStats {
+        std::string name;
+        float p50 = 0.f;   // Milliseconds
+        float p95 = 0.f;
+        float p99 = 0.f;
+        float max = 0.f;
+        float last = 0.f;
+    };
+
+private:
+    static constexpr std::size_t WINDOW_SIZE = 240;  // ~4 seconds of ticks at 60 Hz
+
+    struct Section {
+        const char* name;
+        std::vector<float> samples;  // Ring buffer of milliseconds
+        std::size_t next = 0;
+        float last = 0.f;
+    };
+
+    mutable std::mutex mutex;
+    std::vector<Section> sections;  // Few sections, in first-recorded order
+
+    Profiler() = default;
+
+public:
+    static Profiler& instance();
+
+    void record(const char* section, float milliseconds);
+    std::vector<SectionStats> getStats() const;
+    std::string formatReport() const;  // One line per section, for the overlay
+    void clear();
+};
+
+// Times its own lifetime and records it under `section` when destroyed.
+// `section` must be a string literal (it is kept by pointer).
+class ScopedTimer {
+private:
+    const char* section;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit ScopedTimer(const char* section);
+    ~ScopedTimer();
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
@@ -1,27 +1,38 @@
 #include "projectile.hpp"
 #include "enemy.hpp"
 #include <cmath>
+#include <algorithm>
 
 const float Projectile::radius = 5.f;
 
-Projectile::Projectile(sf::Vector2f start, sf::Vector2f dir, float spd, int dmg, float aoe, Enemy* target)
-    : position(start),
-      direction(dir),
-      speed(spd),
-      damage(dmg),
-      active(true),
-      aoeRadius(aoe),
-      target(target) 
-{
+Projectile::Projectile(sf::Vector2f start, sf::Vector2f dir, float spd, int dmg, float aoe, Enemy* target) {
     shape.setRadius(radius);
-    shape.setFillColor(aoeRadius > 0 ? sf::Color::Yellow : sf::Color::Red);
     shape.setOrigin({radius, radius});
+    reset(start, dir, spd, dmg, aoe, target);
+}
+
+void Projectile::reset(sf::Vector2f start, sf::Vector2f dir, float spd, int dmg, float aoe, Enemy* newTarget) {
+    id = -1;
+    position = start;
+    previousPosition = start;
+    direction = dir;
+    speed = spd;
+    damage = dmg;
+    active = true;
+    aoeRadius = aoe;
+    target = newTarget;
+    projectileType = ProjectileType::Gatling;
+
+    shape.setFillColor(aoeRadius > 0 ? sf::Color::Yellow : sf::Color::Red);
     shape.setPosition(position);
+    sprite.reset();
 }
 
 void Projectile::update(float deltaTime) {
     if (!active) return;
 
+    previousPosition = position;
+
     // Projectiles move in a straight line, no homing
     position += direction * speed * deltaTime;
     shape.setPosition(position);
@@ -30,18 +41,15 @@ void Projectile::update(float deltaTime) {
     if (sprite) {
         sprite->setPosition(position);
     }
-    
-    if (position.x < -50 || position.x > 1000 || position.y < -50 || position.y > 800) {
-        active = false;
-    }
 }
 
-void Projectile::draw(sf::RenderWindow& window) {
+void Projectile::draw(RenderList& out) {
     if (active) {
+        sf::Vector2f motion = position - previousPosition;
         if (sprite) {
-            window.draw(*sprite);
+            out.add(*sprite, motion);
         } else {
-            window.draw(shape);
+            out.add(shape, motion);
         }
     }
 }
@@ -69,7 +77,18 @@ void Projectile::setTexture(sf::Texture& texture) {
 bool Projectile::checkCollision(Enemy* enemy) {
     if (!active || !enemy || enemy->isDead()) return false;
     
-    float dist = std::hypot(enemy->getPosition().x - position.x, enemy->getPosition().y - position.y);
+    // Test the whole segment travelled this tick so fast projectiles (or low
+    // tick rates) can't step over an enemy
+    sf::Vector2f travel = position - previousPosition;
+    sf::Vector2f toEnemy = enemy->getPosition() - previousPosition;
+    float travelSq = travel.x * travel.x + travel.y * travel.y;
+    float t = 0.f;
+    if (travelSq > 0.f) {
+        t = std::clamp((toEnemy.x * travel.x + toEnemy.y * travel.y) / travelSq, 0.f, 1.f);
+    }
+    sf::Vector2f closest = previousPosition + travel * t;
+
+    float dist = std::hypot(enemy->getPosition().x - closest.x, enemy->getPosition().y - closest.y);
     float hitRange = radius + 12.f;
     
     if (dist <= hitRange) {
@@ -1,6 +1,7 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <optional>
+#include "render_list.hpp"
 
 class Enemy;
 
@@ -11,7 +12,9 @@ enum class ProjectileType {
 
 class Projectile {
 public:
+    int id;  // Spawn order, used to order damage events
     sf::Vector2f position;
+    sf::Vector2f previousPosition;  // Position before the last update, for interpolation
     sf::Vector2f direction;
     float speed;
     int damage;
@@ -27,9 +30,12 @@ public:
     static const float radius;
 
     Projectile(sf::Vector2f start, sf::Vector2f dir, float speed, int dmg, float aoe = 0.f, Enemy* target = nullptr);
+
+    // Reinitialize a spent projectile for reuse; the shape keeps its vertices
+    void reset(sf::Vector2f start, sf::Vector2f dir, float speed, int dmg, float aoe = 0.f, Enemy* target = nullptr);
     
     void update(float deltaTime);
-    void draw(sf::RenderWindow& window);
+    void draw(RenderList& out);
     void setTexture(sf::Texture& texture);  // Method to set projectile texture
     
     bool checkCollision(Enemy* enemy);
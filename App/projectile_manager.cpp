@@ -2,19 +2,31 @@
 #include "asset_manager.hpp"
 #include "projectile.hpp"
 #include "enemy.hpp"
+#include "job_system.hpp"
+#include "memory_tracker.hpp"
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 
 ProjectileManager::ProjectileManager(AssetManager* assets) : assetManager(assets) {}
 
 void ProjectileManager::spawnProjectile(sf::Vector2f start, sf::Vector2f dir, float speed, int dmg, float aoeRadius, Enemy* target, ProjectileType type) {
+    MemoryScope memory(MemoryTag::Projectiles);
     if (target == nullptr) { 
         float len = std::hypot(dir.x, dir.y);
         if (len != 0) dir /= len;
     }
-    auto projectile = std::make_unique<Projectile>(start, dir, speed, dmg, aoeRadius, target);
-    
+    std::unique_ptr<Projectile> projectile;
+    if (!spentProjectiles.empty()) {
+        projectile = std::move(spentProjectiles.back());
+        spentProjectiles.pop_back();
+        projectile->reset(start, dir, speed, dmg, aoeRadius, target);
+    } else {
+        projectile = std::make_unique<Projectile>(start, dir, speed, dmg, aoeRadius, target);
+    }
+
     projectile->projectileType = type;
+    projectile->id = nextProjectileId++;
 
     // Apply texture if available
     if (assetManager) {
@@ -32,29 +44,55 @@ void ProjectileManager::spawnProjectile(sf::Vector2f start, sf::Vector2f dir, fl
 }
 
 void ProjectileManager::update(float deltaTime, std::vector<std::unique_ptr<Enemy>>& enemies) {
-    for (auto& projectile : projectiles) {
-        if (!projectile->active) continue;
+    MemoryScope memory(MemoryTag::Projectiles);
+    // Move projectiles, find what they hit and record the damage. Nothing is
+    // applied yet, so each chunk only reads enemies and this runs in parallel.
+    hitEnemyIndices.assign(projectiles.size(), -1);
 
-        projectile->update(deltaTime);
+    auto integrate = [this, deltaTime, &enemies](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            Projectile& projectile = *projectiles[i];
+            if (!projectile.active) continue;
 
-        for (auto& enemy : enemies) {
-            if (enemy->isDead()) continue;
+            projectile.update(deltaTime);
+            if (!worldBounds.contains(projectile.position)) {
+                projectile.active = false;  // Left the map
+                continue;
+            }
 
-            if (projectile->checkCollision(enemy.get())) {
-                // Create explosion for Artillery projectiles BEFORE applying damage
-                if (projectile->projectileType == ProjectileType::Artillery) {
-                    explosions.push_back(Explosion(enemy->getPosition()));
-                }
-                if (projectile->aoeRadius > 0) {
-                    applyAoEDamage(enemy->getPosition(), projectile->aoeRadius, projectile->damage, enemies);
-                } else {
-                    enemy->takeDamage(projectile->damage);
+            for (std::size_t j = 0; j < enemies.size(); j++) {
+                Enemy* enemy = enemies[j].get();
+                if (enemy->isDead()) continue;
+
+                if (projectile.checkCollision(enemy)) {
+                    hitEnemyIndices[i] = static_cast<int>(j);
+                    if (projectile.aoeRadius > 0) {
+                        queueAoEDamage(projectile.id, enemy->getPosition(), projectile.aoeRadius,
+                                       projectile.damage, enemies);
+                    } else {
+                        damageQueue.push({projectile.id, enemy->getId(), projectile.damage});
+                    }
+                    break;
                 }
-                break;
             }
         }
+    };
+    if (jobSystem) {
+        jobSystem->parallelFor(projectiles.size(), 64, integrate);
+    } else {
+        integrate(0, projectiles.size());
+    }
+
+    // Create explosions for Artillery impacts, at the position they hit
+    for (std::size_t i = 0; i < projectiles.size(); i++) {
+        if (hitEnemyIndices[i] < 0) continue;
+        if (projectiles[i]->projectileType == ProjectileType::Artillery) {
+            explosions.push_back(Explosion(enemies[hitEnemyIndices[i]]->getPosition()));
+        }
     }
 
+    damageQueue.resolve(enemies);
+
     const float frameTime = 0.1f; // 0.1 seconds per frame
     for (auto& explosion : explosions) {
         explosion.elapsed += deltaTime;
@@ -65,25 +103,30 @@ void ProjectileManager::update(float deltaTime, std::vector<std::unique_ptr<Enem
         }
     }
 
-    projectiles.erase(
-        std::remove_if(projectiles.begin(), projectiles.end(),
-                       [](const std::unique_ptr<Projectile>& p) { return !p->active; }),
-        projectiles.end());
+    for (auto& projectile : projectiles) {
+        if (!projectile->active) spentProjectiles.push_back(std::move(projectile));
+    }
+    projectiles.erase(std::remove(projectiles.begin(), projectiles.end(), nullptr), projectiles.end());
     explosions.erase(
         std::remove_if(explosions.begin(), explosions.end(),
                        [](const Explosion& e) { return !e.active; }),
         explosions.end());
 }
 
-void ProjectileManager::draw(sf::RenderWindow& window) {
+void ProjectileManager::draw(RenderList& out, const sf::FloatRect& visibleArea) {
     for (auto& projectile : projectiles) {
-        projectile->draw(window);
+        if (visibleArea.contains(projectile->position)) {
+            projectile->draw(out);
+        }
     }
     
     // Draw explosions
     if (assetManager) {
         for (const auto& explosion : explosions) {
-            std::string textureName = "explosion" + std::to_string(explosion.currentFrame + 1);
+            if (!visibleArea.contains(explosion.position)) continue;
+
+            char textureName[24];
+            std::snprintf(textureName, sizeof(textureName), "explosion%d", explosion.currentFrame + 1);
             
             if (assetManager->hasTexture(textureName)) {
                 sf::Sprite explosionSprite(assetManager->getTexture(textureName));
@@ -96,15 +139,16 @@ void ProjectileManager::draw(sf::RenderWindow& window) {
                 float scale = 60.f / texSize.x; // 60 pixels wide
                 explosionSprite.setScale({scale, scale});  // Use braces for Vector2f
                 
-                window.draw(explosionSprite);
+                out.add(explosionSprite);
             }
         }
     }
 }
 
-void ProjectileManager::applyAoEDamage(sf::Vector2f center, float radius, int damage, std::vector<std::unique_ptr<Enemy>>& enemies) {
+void ProjectileManager::queueAoEDamage(int sourceId, sf::Vector2f center, float radius, int damage,
+                                       const std::vector<std::unique_ptr<Enemy>>& enemies) {
     float radiusSq = radius * radius;
-    for (auto& enemy : enemies) {
+    for (const auto& enemy : enemies) {
         if (enemy->isDead()) continue;
 
         sf::Vector2f enemyPos = enemy->getPosition();
@@ -116,7 +160,7 @@ void ProjectileManager::applyAoEDamage(sf::Vector2f center, float radius, int da
             float distance = std::sqrt(distanceSq);
             float damageMultiplier = 1.0f - (distance / radius);
             int finalDamage = static_cast<int>(damage * damageMultiplier);
-            enemy->takeDamage(finalDamage);
+            damageQueue.push({sourceId, enemy->getId(), finalDamage});
         }
     }
-}
\ No newline at end of file
+}
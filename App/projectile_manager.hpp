@@ -3,10 +3,12 @@
 #include <memory>
 #include <SFML/Graphics.hpp>
 #include "projectile.hpp"
+#include "damage_queue.hpp"
 
 class Enemy;
 class Projectile;
 class AssetManager;
+class JobSystem;
 
 struct Explosion {
     sf::Vector2f position;
@@ -21,15 +23,31 @@ struct Explosion {
 class ProjectileManager {
 private:
     std::vector<std::unique_ptr<Projectile>> projectiles;
+    std::vector<std::unique_ptr<Projectile>> spentProjectiles;  // Reused by spawnProjectile, so firing doesn't allocate
     std::vector<Explosion> explosions;  // Add this line
     AssetManager* assetManager;
+    JobSystem* jobSystem = nullptr;
+    std::vector<int> hitEnemyIndices;  // Per projectile: enemy hit this tick, or -1
+    DamageQueue damageQueue;           // Hits recorded this tick, resolved in one ordered pass
+    int nextProjectileId = 0;
+    sf::FloatRect worldBounds{{-50.f, -50.f}, {1060.f, 850.f}};  // Projectiles leaving this are dropped
 
-    void applyAoEDamage(sf::Vector2f center, float radius, int damage, std::vector<std::unique_ptr<Enemy>>& enemies);
+    void queueAoEDamage(int sourceId, sf::Vector2f center, float radius, int damage,
+                        const std::vector<std::unique_ptr<Enemy>>& enemies);
 
 public:
     ProjectileManager(AssetManager* assets = nullptr);
 
+    void setJobSystem(JobSystem* jobs) { jobSystem = jobs; }
+
     void spawnProjectile(sf::Vector2f start, sf::Vector2f dir, float speed, int dmg, float aoeRadius = 0.f, Enemy* target = nullptr, ProjectileType type = ProjectileType::Gatling);
     void update(float deltaTime, std::vector<std::unique_ptr<Enemy>>& enemies);
-    void draw(sf::RenderWindow& window);
+    void draw(RenderList& out, const sf::FloatRect& visibleArea);  // Skips anything outside visibleArea
+
+    // Map area plus a margin, so shots can leave the screen edge before vanishing
+    void setWorldBounds(const sf::FloatRect& bounds) {
+        worldBounds = sf::FloatRect(bounds.position - sf::Vector2f(50.f, 50.f), bounds.size + sf::Vector2f(100.f, 100.f));
+    }
+
+    std::size_t getProjectileCount() const { return projectiles.size(); }
 };
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include "render_list.hpp"
+#include <type_traits>
+
+void RenderList::add(const sf::RectangleShape& shape, sf::Vector2f motion) {
+    items.push_back({shape, motion, 0.f});
+}
+
+void RenderList::add(const sf::CircleShape& shape, sf::Vector2f motion) {
+    items.push_back({shape, motion, 0.f});
+}
+
+void RenderList::add(const sf::Sprite& sprite, sf::Vector2f motion, float turn) {
+    items.push_back({sprite, motion, turn});
+}
+
+void RenderList::add(std::shared_ptr<const TileLayer> tiles) {
+    if (tiles) items.push_back({std::move(tiles), {}, 0.f});
+}
+
+void RenderList::draw(sf::RenderTarget& target, float alpha) const {
+    for (const Item& item : items) {
+        sf::RenderStates states;
+
+        // Pull moving objects back towards where they were last tick
+        if (item.motion != sf::Vector2f()) {
+            states.transform.translate(item.motion * (alpha - 1.f));
+        }
+
+        std::visit([&target, &states, &item, alpha](const auto& drawable) {
+            using T = std::decay_t<decltype(drawable)>;
+            if constexpr (std::is_same_v<T, std::shared_ptr<const TileLayer>>) {
+                states.texture = drawable->texture;
+                target.draw(drawable->vertices, states);
+            } else {
+                // Likewise turn rotating objects back towards last tick's angle
+                if (item.turn != 0.f) {
+                    states.transform.rotate(sf::degrees(item.turn * (alpha - 1.f)), drawable.getPosition());
+                }
+                target.draw(drawable, states);
+            }
+        }, item.drawable);
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <variant>
+#include <vector>
+#include <memory>
+
+// Pre-built tile geometry. Shared between render lists until the grid
+// changes, at which point the grid builds a new layer instead of editing it.
+struct TileLayer {
+    sf::VertexArray vertices;
+    const sf::Texture* texture = nullptr;
+};
+
+// A captured frame of world drawables. Game objects add copies of their
+// shapes/sprites here instead of drawing straight to the window, so the list
+// can be handed to another thread and drawn later.
+class RenderList {
+public:
+    using Drawable = std::variant<sf::RectangleShape, sf::CircleShape, sf::Sprite,
+                                  std::shared_ptr<const TileLayer>>;
+
+    struct Item {
+        Drawable drawable;
+        sf::Vector2f motion;  // How far the owner moved during the last tick
+        float turn;           // Degrees it rotated about its own position during the last tick
+    };
+
+private:
+    std::vector<Item> items;
+
+public:
+    void add(const sf::RectangleShape& shape, sf::Vector2f motion = {});
+    void add(const sf::CircleShape& shape, sf::Vector2f motion = {});
+    void add(const sf::Sprite& sprite, sf::Vector2f motion = {}, float turn = 0.f);
+    void add(std::shared_ptr<const TileLayer> tiles);
+
+    void clear() { items.clear(); }  // Keeps capacity for the next frame
+    std::size_t size() const { return items.size(); }
+
+    // alpha in [0, 1] blends from the previous tick (0) to the latest (1)
+    void draw(sf::RenderTarget& target, float alpha) const;
+};
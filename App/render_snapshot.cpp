@@ -0,0 +1,18 @@
+#include "render_snapshot.hpp"
+#include <utility>
+
+void SnapshotBuffer::publish() {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::swap(writeIndex, readyIndex);
+    hasReady = true;
+}
+
+const RenderSnapshot* SnapshotBuffer::acquireLatest() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (hasReady) {
+        std::swap(readIndex, readyIndex);
+        hasReady = false;
+        hasRead = true;
+    }
+    return hasRead ? &slots[readIndex] : nullptr;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <mutex>
+#include "render_list.hpp"
+#include "tower.hpp"
+#include "profiler.hpp"
+
+// Everything the renderer needs to draw one simulation tick.
+// Once published it is never modified by the simulation.
+struct RenderSnapshot {
+    RenderList world;
+    std::chrono::steady_clock::time_point tickTime;  // When the captured tick finished
+    TickStats tickStats;
+    bool showProfiler = false;
+    bool showMemory = false;
+
+    // UI numbers
+    int money = 0;
+    int lives = 0;
+    int wave = 0;
+    TowerType selectedTower = TowerType::Barrier;
+    int selectedTowerCost = 0;
+    TargetMode selectedTargetMode = TargetMode::Closest;
+
+    sf::View camera;  // World view the frame was captured for
+
+    // Placement preview under the mouse
+    bool previewInMap = false;
+    sf::Vector2i previewCell;
+    bool previewCanPlace = false;
+};
+
+// Triple buffer between the simulation and the render thread. The writer
+// always has a free slot and the reader always gets the newest complete
+// snapshot; neither side ever waits for the other to finish.
+class SnapshotBuffer {
+private:
+    RenderSnapshot slots[3];
+    std::mutex mutex;  // Only guards the index swaps
+    int writeIndex = 0;
+    int readyIndex = 1;
+    int readIndex = 2;
+    bool hasReady = false;    // readyIndex holds a snapshot not yet read
+    bool hasRead = false;     // readIndex holds a valid snapshot
+
+public:
+    RenderSnapshot& beginWrite() { return slots[writeIndex]; }
+    void publish();
+
+    // Newest published snapshot, or nullptr if nothing was published yet.
+    // Stays valid until the next call from the same (reader) thread.
+    const RenderSnapshot* acquireLatest();
+};
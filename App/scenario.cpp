@@ -0,0 +1,134 @@
+#include "scenario.hpp"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+TowerType parseTowerType(const std::string& name, int lineNumber) {
+    if (name == "barrier") return TowerType::Barrier;
+    if (name == "gatling") return TowerType::Gatling;
+    if (name == "frost") return TowerType::Frost;
+    if (name == "artillery") return TowerType::Artillery;
+    throw std::runtime_error("line " + std::to_string(lineNumber) + ": unknown tower type '" + name + "'");
+}
+
+TargetMode parseTargetMode(const std::string& name, int lineNumber) {
+    if (name == "closest") return TargetMode::Closest;
+    if (name == "first") return TargetMode::First;
+    if (name == "last") return TargetMode::Last;
+    if (name == "strongest") return TargetMode::Strongest;
+    if (name == "weakest") return TargetMode::Weakest;
+    throw std::runtime_error("line " + std::to_string(lineNumber) + ": unknown target mode '" + name + "'");
+}
+
+}  // namespace
+
+Scenario loadScenario(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("Could not open scenario " + path);
+    }
+
+    Scenario scenario;
+    scenario.name = path;
+    bool startSet = false, endSet = false;
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream in(line);
+        std::string key;
+        if (!(in >> key)) continue;  // Blank or comment-only
+
+        bool ok = true;
+        if (key == "map") {
+            ok = static_cast<bool>(in >> scenario.width >> scenario.height) &&
+                 scenario.width > 0 && scenario.height > 0;
+        } else if (key == "start") {
+            ok = static_cast<bool>(in >> scenario.start.x >> scenario.start.y);
+            startSet = true;
+        } else if (key == "end") {
+            ok = static_cast<bool>(in >> scenario.end.x >> scenario.end.y);
+            endSet = true;
+        } else if (key == "seed") {
+            ok = static_cast<bool>(in >> scenario.seed);
+        } else if (key == "money") {
+            ok = static_cast<bool>(in >> scenario.money);
+        } else if (key == "lives") {
+            ok = static_cast<bool>(in >> scenario.lives);
+        } else if (key == "duration") {
+            ok = static_cast<bool>(in >> scenario.durationTicks);
+        } else if (key == "tower") {
+            ScenarioTower tower;
+            std::string type;
+            ok = static_cast<bool>(in >> tower.tick >> type >> tower.cell.x >> tower.cell.y);
+            if (ok) {
+                tower.type = parseTowerType(type, lineNumber);
+                std::string mode;
+                if (in >> mode) tower.mode = parseTargetMode(mode, lineNumber);
+                scenario.towers.push_back(tower);
+            }
+        } else if (key == "steady") {
+            ok = static_cast<bool>(in >> scenario.steadyFromTick) && scenario.steadyFromTick >= 0;
+        } else if (key == "wave") {
+            ScenarioWave wave;
+            ok = static_cast<bool>(in >> wave.tick >> wave.count >> wave.interval);
+            if (ok) scenario.waves.push_back(wave);
+        } else {
+            throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": unknown directive '" + key + "'");
+        }
+
+        if (!ok) {
+            throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": malformed '" + key + "' line");
+        }
+    }
+
+    // Default to the game's layout: left edge to right edge, halfway down
+    if (!startSet) scenario.start = {0, scenario.height / 2};
+    if (!endSet) scenario.end = {scenario.width - 1, scenario.height / 2};
+
+    auto inBounds = [&scenario](sf::Vector2i cell) {
+        return cell.x >= 0 && cell.y >= 0 && cell.x < scenario.width && cell.y < scenario.height;
+    };
+    if (!inBounds(scenario.start) || !inBounds(scenario.end)) {
+        throw std::runtime_error(path + ": start/end outside the map");
+    }
+
+    // Stable, so same-tick events keep file order
+    std::stable_sort(scenario.towers.begin(), scenario.towers.end(),
+                     [](const ScenarioTower& a, const ScenarioTower& b) { return a.tick < b.tick; });
+    std::stable_sort(scenario.waves.begin(), scenario.waves.end(),
+                     [](const ScenarioWave& a, const ScenarioWave& b) { return a.tick < b.tick; });
+    return scenario;
+}
+
+std::size_t getPeakResidentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return static_cast<std::size_t>(usage.ru_maxrss);         // Bytes on macOS
+#else
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;  // Kilobytes on Linux
+#endif
+#endif
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <SFML/System.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "tower.hpp"
+
+// A scripted, reproducible game session for headless benchmarking.
+//
+// Text format, one directive per line ('#' starts a comment):
+//   map <width> <height>
+//   start <x> <y>
+//   end <x> <y>
+//   seed <n>                            (enemy type rolls)
+//   money <n>
+//   lives <n>
+//   duration <ticks>
+//   tower <tick> <barrier|gatling|frost|artillery> <x> <y> [closest|first|last|strongest|weakest]
+//   wave <tick> <count> <interval-seconds>
+//   steady <tick>                       (from here on no tick may allocate)
+// Events run at the start of their tick. A wave replaces any enemies the
+// previous wave has not spawned yet, like pressing Space in game.
+// With `steady`, the run fails if any tick from that one on touches the
+// general heap; put it after the last spawn, placement and warm-up.
+struct ScenarioTower {
+    int tick;
+    TowerType type;
+    sf::Vector2i cell;
+    TargetMode mode = TargetMode::Closest;  // Only used by gatling and artillery
+};
+
+struct ScenarioWave {
+    int tick;
+    int count;
+    float interval;
+};
+
+struct Scenario {
+    std::string name;
+    int width = 20;
+    int height = 15;
+    sf::Vector2i start{0, 7};
+    sf::Vector2i end{19, 7};
+    unsigned int seed = 1;
+    int money = 1000;
+    int lives = 20;
+    int durationTicks = 3600;
+    int steadyFromTick = -1;            // -1: no steady-state allocation check
+    std::vector<ScenarioTower> towers;  // Sorted by tick
+    std::vector<ScenarioWave> waves;    // Sorted by tick
+};
+
+// Throws std::runtime_error on unreadable files or malformed lines
+Scenario loadScenario(const std::string& path);
+
+// Peak resident set size of this process so far, or 0 if unknown
+std::size_t getPeakResidentBytes();
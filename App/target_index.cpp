@@ -0,0 +1,99 @@
+#include "target_index.hpp"
+#include "enemy.hpp"
+#include "grid_units.hpp"
+#include <algorithm>
+
+int TargetIndex::bucketOf(sf::Vector2f position) const {
+    sf::Vector2i cell = worldToCell(position);
+    int bx = std::clamp(cell.x / BUCKET_CELLS, 0, bucketsX - 1);
+    int by = std::clamp(cell.y / BUCKET_CELLS, 0, bucketsY - 1);
+    return by * bucketsX + bx;
+}
+
+// Sort `ranking` by key (then ID) and write each enemy's place into `field`
+void TargetIndex::rank(int Entry::*field) {
+    std::sort(ranking.begin(), ranking.end(), [](const Ranked& a, const Ranked& b) {
+        return a.key < b.key || (a.key == b.key && a.id < b.id);
+    });
+    for (std::size_t r = 0; r < ranking.size(); r++) {
+        unsorted[ranking[r].slot].*field = static_cast<int>(r);
+    }
+}
+
+void TargetIndex::rebuild(const std::vector<std::unique_ptr<Enemy>>& enemies, int gridWidth, int gridHeight) {
+    std::size_t count = enemies.size();
+    unsorted.resize(count);
+    ranking.resize(count);
+    for (std::size_t i = 0; i < count; i++) {
+        unsorted[i] = {enemies[i].get(), enemies[i]->getPosition(), 0, 0};
+    }
+
+    for (std::size_t i = 0; i < count; i++) {
+        ranking[i] = {enemies[i]->getRemainingDistance(), enemies[i]->getId(), i};
+    }
+    rank(&Entry::progressRank);
+
+    for (std::size_t i = 0; i < count; i++) {
+        ranking[i] = {-static_cast<float>(enemies[i]->getHealth()), enemies[i]->getId(), i};
+    }
+    rank(&Entry::healthRank);
+
+    // Counting sort into buckets
+    bucketsX = std::max((gridWidth + BUCKET_CELLS - 1) / BUCKET_CELLS, 1);
+    bucketsY = std::max((gridHeight + BUCKET_CELLS - 1) / BUCKET_CELLS, 1);
+    bucketStart.assign(static_cast<std::size_t>(bucketsX) * bucketsY + 1, 0);
+    for (const Entry& entry : unsorted) {
+        bucketStart[bucketOf(entry.position) + 1]++;
+    }
+    for (std::size_t b = 1; b < bucketStart.size(); b++) {
+        bucketStart[b] += bucketStart[b - 1];
+    }
+
+    bucketFill.assign(bucketStart.begin(), bucketStart.end() - 1);
+    entries.resize(count);
+    for (const Entry& entry : unsorted) {
+        entries[bucketFill[bucketOf(entry.position)]++] = entry;
+    }
+}
+
+Enemy* TargetIndex::find(sf::Vector2f center, float range, TargetMode mode) const {
+    if (entries.empty()) return nullptr;
+
+    sf::Vector2i low = worldToCell(center - sf::Vector2f(range, range));
+    sf::Vector2i high = worldToCell(center + sf::Vector2f(range, range));
+    int minX = std::max(low.x / BUCKET_CELLS, 0), maxX = std::min(high.x / BUCKET_CELLS, bucketsX - 1);
+    int minY = std::max(low.y / BUCKET_CELLS, 0), maxY = std::min(high.y / BUCKET_CELLS, bucketsY - 1);
+
+    Enemy* best = nullptr;
+    float bestScore = 0.f;
+    float rangeSq = range * range;
+    for (int by = minY; by <= maxY; by++) {
+        for (int bx = minX; bx <= maxX; bx++) {
+            int bucket = by * bucketsX + bx;
+            for (int i = bucketStart[bucket]; i < bucketStart[bucket + 1]; i++) {
+                const Entry& entry = entries[i];
+                if (entry.enemy->isDead()) continue;
+
+                float dx = center.x - entry.position.x;
+                float dy = center.y - entry.position.y;
+                float distanceSq = dx * dx + dy * dy;
+                if (distanceSq > rangeSq) continue;
+
+                // Lower is better
+                float score = 0.f;
+                switch (mode) {
+                    case TargetMode::Closest:   score = distanceSq; break;
+                    case TargetMode::First:     score = static_cast<float>(entry.progressRank); break;
+                    case TargetMode::Last:      score = -static_cast<float>(entry.progressRank); break;
+                    case TargetMode::Strongest: score = static_cast<float>(entry.healthRank); break;
+                    case TargetMode::Weakest:   score = -static_cast<float>(entry.healthRank); break;
+                }
+                if (!best || score < bestScore) {
+                    best = entry.enemy;
+                    bestScore = score;
+                }
+            }
+        }
+    }
+    return best;
+}
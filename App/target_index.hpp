@@ -0,0 +1,51 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <memory>
+#include "tower.hpp"
+
+class Enemy;
+
+// Live enemies ranked for targeting, rebuilt by EnemyManager once per tick.
+// Every enemy gets its rank by distance left to the goal and by health,
+// and is filed in a coarse grid of BUCKET_CELLS x BUCKET_CELLS map cells.
+// A tower only looks at the buckets its range overlaps and keeps the best
+// rank it sees there, so picking the first, last, strongest, weakest or
+// closest enemy costs the enemies near that tower instead of all of them.
+class TargetIndex {
+public:
+    static constexpr int BUCKET_CELLS = 4;
+
+private:
+    struct Entry {
+        Enemy* enemy;
+        sf::Vector2f position;
+        int progressRank;  // 0 = nearest the goal
+        int healthRank;    // 0 = most health
+    };
+    struct Ranked {
+        float key;
+        int id;            // Breaks ties, so equal keys rank the same every run
+        std::size_t slot;
+    };
+
+    std::vector<Entry> entries;    // Grouped by bucket
+    std::vector<int> bucketStart;  // Bucket b holds entries[bucketStart[b], bucketStart[b + 1])
+    int bucketsX = 0, bucketsY = 0;
+
+    // Reused between rebuilds
+    std::vector<Entry> unsorted;
+    std::vector<Ranked> ranking;
+    std::vector<int> bucketFill;
+
+    int bucketOf(sf::Vector2f position) const;
+    void rank(int Entry::*field);
+
+public:
+    void rebuild(const std::vector<std::unique_ptr<Enemy>>& enemies, int gridWidth, int gridHeight);
+
+    // Best enemy within `range` of `center` by `mode`, or null
+    Enemy* find(sf::Vector2f center, float range, TargetMode mode) const;
+
+    std::size_t size() const { return entries.size(); }
+};
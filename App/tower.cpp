@@ -1,4 +1,6 @@
 #include "Tower.hpp"
+#include "target_index.hpp"
+#include "grid_units.hpp"
 #include <cmath>
 
 Tower::Tower(sf::Vector2f pos, float range, float fireRate, int cost, bool isBlocking, TowerType type)
@@ -9,9 +11,17 @@ Tower::Tower(sf::Vector2f pos, float range, float fireRate, int cost, bool isBlo
       cost(cost),
       isBlocking(isBlocking),
       type(type),
-      currentRotation(-90.f)
+      currentRotation(-90.f),
+      previousRotation(-90.f)
 {}
 
+float Tower::getTurn() const {
+    float turn = currentRotation - previousRotation;
+    while (turn > 180.f) turn -= 360.f;
+    while (turn < -180.f) turn += 360.f;
+    return turn;
+}
+
 bool Tower::canAttack(Enemy* enemy) {
     if (!enemy) return false;
     sf::Vector2f enemyPos = enemy->getPosition();
@@ -21,6 +31,42 @@ bool Tower::canAttack(Enemy* enemy) {
     return distanceSq <= (range * range);
 }
 
+Enemy* Tower::findClosestEnemy(const std::vector<std::unique_ptr<Enemy>>& enemies) const {
+    Enemy* closest = nullptr;
+    float minDistance = range * range;
+
+    for (const auto& enemy : enemies) {
+        if (enemy->isDead()) continue;
+
+        sf::Vector2f enemyPos = enemy->getPosition();
+        float dx = position.x - enemyPos.x;
+        float dy = position.y - enemyPos.y;
+        float distanceSq = dx * dx + dy * dy;
+
+        if (distanceSq <= minDistance) {
+            minDistance = distanceSq;
+            closest = enemy.get();
+        }
+    }
+    return closest;
+}
+
+Enemy* Tower::findTarget(const std::vector<std::unique_ptr<Enemy>>& enemies) const {
+    if (!targetIndex) return findClosestEnemy(enemies);
+    return targetIndex->find(position, range, targetMode);
+}
+
+const char* getTargetModeName(TargetMode mode) {
+    switch (mode) {
+        case TargetMode::Closest:   return "Closest";
+        case TargetMode::First:     return "First";
+        case TargetMode::Last:      return "Last";
+        case TargetMode::Strongest: return "Strongest";
+        case TargetMode::Weakest:   return "Weakest";
+    }
+    return "Unknown";
+}
+
 void Tower::setBaseTexture(sf::Texture& texture) {
     baseSprite.emplace(texture);
     
@@ -28,8 +74,8 @@ void Tower::setBaseTexture(sf::Texture& texture) {
     baseSprite->setOrigin({texSize.x / 2.f, texSize.y / 2.f});
     baseSprite->setPosition(position);
     
-    float scaleX = 48.f / texSize.x;
-    float scaleY = 48.f / texSize.y;
+    float scaleX = CELL_SIZE / texSize.x;
+    float scaleY = CELL_SIZE / texSize.y;
     baseSprite->setScale({scaleX, scaleY});
     // Base does NOT rotate
 }
@@ -41,8 +87,8 @@ void Tower::setShooterTexture(sf::Texture& texture) {
     shooterSprite->setOrigin({texSize.x / 2.f, texSize.y / 2.f});
     shooterSprite->setPosition(position);
     
-    float scaleX = 48.f / texSize.x;
-    float scaleY = 48.f / texSize.y;
+    float scaleX = CELL_SIZE / texSize.x;
+    float scaleY = CELL_SIZE / texSize.y;
     shooterSprite->setScale({scaleX, scaleY});
     
     // Apply initial rotation to shooter only
@@ -4,6 +4,7 @@
 #include <memory>
 #include <optional>
 #include "enemy.hpp"
+#include "render_list.hpp"
 
 // Enumeration for tower types
 enum class TowerType {
@@ -13,6 +14,19 @@ enum class TowerType {
     Artillery
 };
 
+// How a shooting tower chooses between the enemies in its range
+enum class TargetMode {
+    Closest,
+    First,      // Nearest the goal
+    Last,       // Furthest from the goal
+    Strongest,  // Most health
+    Weakest     // Least health
+};
+constexpr int TARGET_MODE_COUNT = 5;
+const char* getTargetModeName(TargetMode mode);
+
+class TargetIndex;
+
 // Abstract Tower base class
 class Tower {
 protected:
@@ -27,14 +41,30 @@ protected:
     std::optional<sf::Sprite> baseSprite;    // Static base
     std::optional<sf::Sprite> shooterSprite; // Rotating shooter
     float currentRotation = -90.f;
+    float previousRotation = -90.f;  // Rotation at the start of the last tick, for interpolation
+
+    Enemy* currentTarget = nullptr;  // Chosen in acquireTarget, consumed in update
+
+    TargetMode targetMode = TargetMode::Closest;
+    const TargetIndex* targetIndex = nullptr;  // Shared by all towers; without it only Closest works
+
+    Enemy* findClosestEnemy(const std::vector<std::unique_ptr<Enemy>>& enemies) const;
+    Enemy* findTarget(const std::vector<std::unique_ptr<Enemy>>& enemies) const;  // By targetMode
 
 public:
     Tower(sf::Vector2f pos, float range, float fireRate, int cost, bool isBlocking, TowerType type);
     virtual ~Tower() = default;
 
     // Core virtual methods
+    // acquireTarget only reads the enemy list and writes this tower's own
+    // state, so it may run for many towers in parallel before update().
+    virtual void acquireTarget(const std::vector<std::unique_ptr<Enemy>>& /*enemies*/) {}
     virtual void update(float deltaTime, std::vector<std::unique_ptr<Enemy>>& enemies) = 0;
-    virtual void draw(sf::RenderWindow& window) = 0;
+    virtual void draw(RenderList& out) = 0;
+
+    void setTargetMode(TargetMode mode) { targetMode = mode; }
+    void setTargetIndex(const TargetIndex* index) { targetIndex = index; }
+    TargetMode getTargetMode() const { return targetMode; }
 
     // Texture support
     void setBaseTexture(sf::Texture& texture);
@@ -44,6 +74,8 @@ public:
     bool canAttack(Enemy* enemy);
 
     void rotateToward(const sf::Vector2f& targetPos);
+    void beginTick() { previousRotation = currentRotation; }
+    float getTurn() const;  // Rotation during the last tick, in [-180, 180]
 
     // Accessors
     const sf::Vector2f& getPosition() const { return position; }
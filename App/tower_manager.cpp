@@ -2,9 +2,15 @@
 #include "asset_manager.hpp"
 #include "grid.hpp"
 #include "a_star_path_finder.hpp"
+#include "hierarchical_pathfinder.hpp"
 #include "enemy_manager.hpp"
 #include "enemy.hpp"
 #include "node.hpp"
+#include "job_system.hpp"
+#include "profiler.hpp"
+#include "memory_tracker.hpp"
+#include "frame_arena.hpp"
+#include "grid_units.hpp"
 
 #include "gatling_tower.hpp"
 #include "frost_tower.hpp"
@@ -16,21 +22,57 @@ TowerManager::TowerManager(Grid* grid, AStarPathfinder* pathfinder, EnemyManager
 }
 
 sf::Vector2f TowerManager::gridToWorld(sf::Vector2i gridPos) {
-    return sf::Vector2f(gridPos.x * 48.f + 24.f, gridPos.y * 48.f + 24.f);
+    return cellToWorld(gridPos.x, gridPos.y);
+}
+
+void TowerManager::setJobSystem(JobSystem* jobs) {
+    jobSystem = jobs;
+    projectileManager.setJobSystem(jobs);
 }
 
 void TowerManager::update(float deltaTime, std::vector<std::unique_ptr<Enemy>>& enemies) {
+    updateTowers(deltaTime, enemies);
+
+    ScopedTimer timer("Projectiles");
+    projectileManager.setWorldBounds(grid->getWorldBounds());
+    projectileManager.update(deltaTime, enemies);
+}
+
+void TowerManager::updateTowers(float deltaTime, std::vector<std::unique_ptr<Enemy>>& enemies) {
+    ScopedTimer timer("Towers");
+    MemoryScope memory(MemoryTag::Towers);
+
+    // Targeting only reads the enemy list, so it is spread across towers
+    auto acquireTargets = [this, &enemies](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            towers[i]->beginTick();
+            towers[i]->acquireTarget(enemies);
+        }
+    };
+    if (jobSystem) {
+        jobSystem->parallelFor(towers.size(), 16, acquireTargets);
+    } else {
+        acquireTargets(0, towers.size());
+    }
+
+    // Firing spawns projectiles, so it stays serial and in placement order
     for (auto& tower : towers) {
         tower->update(deltaTime, enemies);
     }
-    projectileManager.update(deltaTime, enemies);
 }
 
-void TowerManager::draw(sf::RenderWindow& window) {
-    for (auto& tower : towers) {
-        tower->draw(window);
+void TowerManager::draw(RenderList& out, const sf::FloatRect& visibleArea) {
+    {
+        ScopedTimer timer("TowerDraw");
+        for (auto& tower : towers) {
+            if (visibleArea.contains(tower->getPosition())) {
+                tower->draw(out);
+            }
+        }
     }
-    projectileManager.draw(window);
+
+    ScopedTimer timer("ProjDraw");
+    projectileManager.draw(out, visibleArea);
 }
 
 bool TowerManager::isOccupied(sf::Vector2i gridPos) {
@@ -48,7 +90,8 @@ bool TowerManager::isOccupied(sf::Vector2i gridPos) {
     return !node->walkable;
 }
 
-bool TowerManager::placeTower(TowerType type, sf::Vector2i gridPos) {
+bool TowerManager::placeTower(TowerType type, sf::Vector2i gridPos, TargetMode mode) {
+    MemoryScope memory(MemoryTag::Towers);
     if (isOccupied(gridPos)) {
         return false;
     }
@@ -66,10 +109,22 @@ bool TowerManager::placeTower(TowerType type, sf::Vector2i gridPos) {
         grid->setObstacle(gridPos.x, gridPos.y, true);
 
         // Validate that a path still exists from start to end
-        std::vector<Node*> path = pathfinder->findPath(grid->getNode(grid->startCell.x, grid->startCell.y), 
-                                                    grid->getNode(grid->endCell.x, grid->endCell.y));
+        Node* start = grid->getNode(grid->startCell.x, grid->startCell.y);
+        Node* end = grid->getNode(grid->endCell.x, grid->endCell.y);
+        bool pathExists;
+        if (hierarchy && hierarchy->isActive()) {
+            // Entrances span whole open runs, so the coarse route is found exactly when a cell path exists
+            hierarchy->update();
+            std::vector<Node*> route;
+            pathExists = hierarchy->findRoute(start, end, route);
+        } else {
+            // The path itself is thrown away, so it lives in the frame arena
+            ArenaScope scratch;
+            std::pmr::vector<Node*> path(scratch.resource());
+            pathExists = pathfinder->findPath(start, end, path);
+        }
 
-        if (path.empty()) {
+        if (!pathExists) {
             grid->setObstacle(gridPos.x, gridPos.y, false);
             return false;
         }
@@ -84,6 +139,8 @@ bool TowerManager::placeTower(TowerType type, sf::Vector2i gridPos) {
         case TowerType::Gatling: {
             auto tower = std::make_unique<GatlingTower>(worldPos);
             tower->setProjectileManager(&projectileManager);
+            if (enemyManager) tower->setTargetIndex(&enemyManager->getTargetIndex());
+            tower->setTargetMode(mode);
             if (assetManager && assetManager->hasTexture("gatling_tower_base")) {
                 tower->setBaseTexture(assetManager->getTexture("gatling_tower_base"));
                 tower->setShooterTexture(assetManager->getTexture("gatling_tower_shooter"));
@@ -94,6 +151,8 @@ bool TowerManager::placeTower(TowerType type, sf::Vector2i gridPos) {
         case TowerType::Artillery: {
             auto tower = std::make_unique<ArtilleryTower>(worldPos);
             tower->setProjectileManager(&projectileManager);
+            if (enemyManager) tower->setTargetIndex(&enemyManager->getTargetIndex());
+            tower->setTargetMode(mode);
             if (assetManager && assetManager->hasTexture("artillery_tower_base")) {
                 tower->setBaseTexture(assetManager->getTexture("artillery_tower_base"));
                 tower->setShooterTexture(assetManager->getTexture("artillery_tower_shooter"));
@@ -120,9 +179,7 @@ bool TowerManager::placeTower(TowerType type, sf::Vector2i gridPos) {
         }
     }
 
-    if (enemyManager) {
-        enemyManager->recalculatePaths();
-    }
-    
+    // No repath here: EnemyManager picks the changed cells up from the
+    // grid's cost change log on its next update and reroutes whoever they affect
     return true;
 }
\ No newline at end of file
@@ -9,9 +9,11 @@
 
 class Grid;
 class AStarPathfinder;
+class HierarchicalPathfinder;
 class EnemyManager;
 class Enemy;
 class AssetManager;
+class JobSystem;
 
 class TowerManager {
 private:
@@ -19,17 +21,26 @@ private:
     std::set<std::pair<int, int>> occupiedCells;  // Track cells with towers
     Grid* grid;
     AStarPathfinder* pathfinder;
+    HierarchicalPathfinder* hierarchy = nullptr;  // Validates placements on large maps
     EnemyManager* enemyManager;
     ProjectileManager projectileManager;
     AssetManager* assetManager;
+    JobSystem* jobSystem = nullptr;  // Optional - null runs everything on the calling thread
     sf::Vector2f gridToWorld(sf::Vector2i gridPos);
+    void updateTowers(float deltaTime, std::vector<std::unique_ptr<Enemy>>& enemies);
 
 public:
     TowerManager(Grid* grid, AStarPathfinder* pathfinder, EnemyManager* enemyManager, AssetManager* assets = nullptr);
 
+    void setJobSystem(JobSystem* jobs);
+    void setHierarchicalPathfinder(HierarchicalPathfinder* hpa) { hierarchy = hpa; }
+
     void update(float deltaTime, std::vector<std::unique_ptr<Enemy>>& enemies);
-    void draw(sf::RenderWindow& window);
+    void draw(RenderList& out, const sf::FloatRect& visibleArea);  // Skips towers and projectiles outside visibleArea
 
     bool isOccupied(sf::Vector2i gridPos);
-    bool placeTower(TowerType type, sf::Vector2i gridPos);
+    bool placeTower(TowerType type, sf::Vector2i gridPos, TargetMode mode = TargetMode::Closest);
+
+    std::size_t getTowerCount() const { return towers.size(); }
+    std::size_t getProjectileCount() const { return projectileManager.getProjectileCount(); }
 };
\ No newline at end of file
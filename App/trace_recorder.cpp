@@ -0,0 +1,130 @@
+#include "trace_recorder.hpp"
+#include <fstream>
+#include <iostream>
+
+namespace {
+    thread_local std::uint32_t traceThreadId = 0;  // 0 = not assigned yet
+}
+
+TraceRecorder& TraceRecorder::instance() {
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+std::uint32_t TraceRecorder::currentThreadId() {
+    if (traceThreadId == 0) {
+        traceThreadId = nextThreadId.fetch_add(1);
+    }
+    return traceThreadId;
+}
+
+void TraceRecorder::enable(const std::string& path, float seconds) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    basePath = path;
+    if (basePath.size() > 5 && basePath.compare(basePath.size() - 5, 5, ".json") == 0) {
+        basePath.erase(basePath.size() - 5);
+    }
+    captureSeconds = seconds;
+    events.assign(CAPACITY, TraceEvent{nullptr, 0, 0, 0});
+    next = 0;
+    wrapped = false;
+    epoch = std::chrono::steady_clock::now();
+    lastDump = epoch;
+
+    enabled = true;
+    std::cout << "Tracing enabled, keeping the last " << seconds << "s of events" << std::endl;
+}
+
+void TraceRecorder::setThreadName(const std::string& name) {
+    std::uint32_t id = currentThreadId();
+    std::lock_guard<std::mutex> lock(mutex);
+    threadNames[id] = name;
+}
+
+void TraceRecorder::record(const char* name, std::chrono::steady_clock::time_point start,
+                           std::chrono::steady_clock::time_point end) {
+    if (!isEnabled()) return;
+
+    std::uint32_t id = currentThreadId();
+    std::int64_t startUs = std::chrono::duration_cast<std::chrono::microseconds>(start - epoch).count();
+    std::int64_t durationUs = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    events[next] = TraceEvent{name, id, startUs, durationUs};
+    next = (next + 1) % events.size();
+    if (next == 0) wrapped = true;
+}
+
+void TraceRecorder::reportFrame(float frameMilliseconds) {
+    if (!isEnabled() || frameMilliseconds < SPIKE_THRESHOLD_MS) return;
+
+    float sinceDump = std::chrono::duration<float>(std::chrono::steady_clock::now() - lastDump).count();
+    if (dumpCount > 0 && sinceDump < SPIKE_COOLDOWN) return;
+
+    std::cout << "Frame spike (" << frameMilliseconds << " ms), dumping trace" << std::endl;
+    dump();
+}
+
+std::string TraceRecorder::dump() {
+    if (!isEnabled()) return "";
+
+    // Copy out under the lock, write the file without it
+    std::vector<TraceEvent> snapshot;
+    std::map<std::uint32_t, std::string> names;
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::size_t count = wrapped ? events.size() : next;
+        std::size_t first = wrapped ? next : 0;
+        snapshot.reserve(count);
+        for (std::size_t i = 0; i < count; i++) {
+            snapshot.push_back(events[(first + i) % events.size()]);
+        }
+        names = threadNames;
+
+        dumpCount++;
+        lastDump = std::chrono::steady_clock::now();
+        path = basePath + "-" + std::to_string(dumpCount) + ".json";
+    }
+
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Failed to write trace: " << path << std::endl;
+        return "";
+    }
+
+    std::int64_t newest = snapshot.empty() ? 0 : snapshot.back().start + snapshot.back().duration;
+    std::int64_t oldest = newest - static_cast<std::int64_t>(captureSeconds * 1e6f);
+
+    file << "{\"traceEvents\":[\n";
+    bool first = true;
+    for (const auto& [id, name] : names) {
+        file << (first ? "" : ",\n")
+             << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << id
+             << ",\"args\":{\"name\":\"" << name << "\"}}";
+        first = false;
+    }
+    for (const TraceEvent& event : snapshot) {
+        if (event.start < oldest) continue;
+        file << (first ? "" : ",\n")
+             << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId
+             << ",\"ts\":" << event.start << ",\"dur\":" << event.duration << "}";
+        first = false;
+    }
+    file << "\n]}\n";
+
+    std::cout << "Trace written to " << path << std::endl;
+    return path;
+}
+
+TraceScope::TraceScope(const char* name)
+    : name(name), active(TraceRecorder::instance().isEnabled()) {
+    if (active) start = std::chrono::steady_clock::now();
+}
+
+TraceScope::~TraceScope() {
+    if (active) {
+        TraceRecorder::instance().record(name, start, std::chrono::steady_clock::now());
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Ring-buffered capture of timed sections, written out in Chrome's
+// trace-event JSON format (loads in chrome://tracing and ui.perfetto.dev).
+// Disabled by default; recording is a single atomic load until enabled.
+class TraceRecorder {
+private:
+    struct TraceEvent {
+        const char* name;        // String literal
+        std::uint32_t threadId;
+        std::int64_t start;      // Microseconds since enable()
+        std::int64_t duration;   // Microseconds
+    };
+
+    static constexpr std::size_t CAPACITY = 1 << 18;    // Events kept before the oldest are overwritten
+    static constexpr float SPIKE_THRESHOLD_MS = 50.0f;  // A frame this long triggers a dump
+    static constexpr float SPIKE_COOLDOWN = 5.0f;       // Seconds between automatic dumps
+
+    std::atomic<bool> enabled{false};
+    std::mutex mutex;
+    std::vector<TraceEvent> events;   // Ring buffer
+    std::size_t next = 0;
+    bool wrapped = false;
+
+    std::map<std::uint32_t, std::string> threadNames;
+    std::atomic<std::uint32_t> nextThreadId{1};
+
+    std::string basePath;
+    float captureSeconds = 10.0f;
+    int dumpCount = 0;
+    std::chrono::steady_clock::time_point epoch;
+    std::chrono::steady_clock::time_point lastDump;
+
+    TraceRecorder() = default;
+    std::uint32_t currentThreadId();
+
+public:
+    static TraceRecorder& instance();
+
+    // Start capturing; dumps go to <path>-1.json, <path>-2.json, ...
+    void enable(const std::string& path, float seconds);
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    void setThreadName(const std::string& name);  // Names the calling thread in the trace
+    void record(const char* name, std::chrono::steady_clock::time_point start,
+                std::chrono::steady_clock::time_point end);
+
+    // Call once per frame; dumps automatically when the frame was a spike
+    void reportFrame(float frameMilliseconds);
+
+    // Write the last captureSeconds of events. Returns the file written, or
+    // an empty string when tracing is off or the file could not be opened.
+    std::string dump();
+};
+
+// Records its lifetime as a trace event only (no overlay statistics).
+// Used for fine-grained work such as individual job chunks.
+class TraceScope {
+private:
+    const char* name;
+    std::chrono::steady_clock::time_point start;
+    bool active;
+
+public:
+    explicit TraceScope(const char* name);
+    ~TraceScope();
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
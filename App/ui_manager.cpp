@@ -1,4 +1,16 @@
 #include "ui_manager.hpp"
+#include "memory_tracker.hpp"
+#include "grid_units.hpp"
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+namespace {
+    // The static layer is drawn with alpha blending onto a transparent
+    // texture, so its colours already carry their alpha. Compositing it with
+    // plain alpha blending would apply translucent pixels' alpha twice.
+    const sf::BlendMode BLEND_PREMULTIPLIED(sf::BlendMode::Factor::One, sf::BlendMode::Factor::OneMinusSrcAlpha);
+}
 
 UIManager::UIManager(sf::Font& font) {
     // Initialize text objects with the font
@@ -7,6 +19,7 @@ UIManager::UIManager(sf::Font& font) {
     waveText.emplace(font);
     selectedTowerText.emplace(font);
     instructionsText.emplace(font);
+    profilerText.emplace(font);
 
     // UI elements positioned on the right side (grid is 960px wide with 48px cells)
     float uiX = 960.f;  // Grid ends at 960px (20 cells * 48px)
@@ -45,14 +58,22 @@ UIManager::UIManager(sf::Font& font) {
     instructionsText->setCharacterSize(24);
     instructionsText->setFillColor(sf::Color(200, 200, 200));
     instructionsText->setPosition({textX, 355.f});
-    instructionsText->setString("Controls:\n1-4: Select Tower\nSpace: Start Wave\nEsc: Pause");
+    instructionsText->setString("Controls:\n1-4: Select Tower\nTab: Target Mode\nSpace: Start Wave\nEsc: Pause\nF1-F4: Game Speed\nArrows: Scroll\nWheel: Zoom");
+
+    // Setup profiler overlay
+    profilerText->setCharacterSize(14);
+    profilerText->setFillColor(sf::Color::White);
+    profilerText->setPosition({8.f, 8.f});
+    profilerBackground.setPosition({0.f, 0.f});
+    profilerBackground.setFillColor(sf::Color(0, 0, 0, 170));
 
     // Setup tower preview shape
-    towerPreview.setSize({48.f - 2.f, 48.f - 2.f});
+    towerPreview.setSize({CELL_SIZE - 2.f, CELL_SIZE - 2.f});
 }
 
 void UIManager::setUIPanelTexture(sf::Texture& texture) {
     uiPanelSprite.emplace(texture);
+    staticLayerDirty = true;
     
     // Position and scale the UI panel texture
     uiPanelSprite->setPosition({960.f, 0.f});
@@ -63,32 +84,85 @@ void UIManager::setUIPanelTexture(sf::Texture& texture) {
     uiPanelSprite->setScale({scaleX, scaleY});
 }
 
-void UIManager::update(int money, int lives, int wave, TowerType selectedTower, int selectedTowerCost) {
-    // Update text strings with current game state
-    moneyText->setString("Money: $" + std::to_string(money));
-    livesText->setString("Lives: " + std::to_string(lives));
-    waveText->setString("Wave: " + std::to_string(wave));
-    
-    std::string towerInfo = "Selected: " + getTowerName(selectedTower) + 
-                           " ($" + std::to_string(selectedTowerCost) + ")";
-    selectedTowerText->setString(towerInfo);
+void UIManager::update(int money, int lives, int wave, TowerType selectedTower, int selectedTowerCost, TargetMode targetMode) {
+    MemoryScope memory(MemoryTag::UI);
+
+    // setString re-lays out the glyphs, so only touch text whose value
+    // changed. Formatted on the stack to keep std::string out of it.
+    char line[64];
+    if (money != shownMoney) {
+        shownMoney = money;
+        std::snprintf(line, sizeof(line), "Money: $%d", money);
+        moneyText->setString(line);
+    }
+    if (lives != shownLives) {
+        shownLives = lives;
+        std::snprintf(line, sizeof(line), "Lives: %d", lives);
+        livesText->setString(line);
+    }
+    if (wave != shownWave) {
+        shownWave = wave;
+        std::snprintf(line, sizeof(line), "Wave: %d", wave);
+        waveText->setString(line);
+    }
+    if (selectedTower != shownTower || selectedTowerCost != shownTowerCost || targetMode != shownTargetMode) {
+        shownTower = selectedTower;
+        shownTowerCost = selectedTowerCost;
+        shownTargetMode = targetMode;
+        std::snprintf(line, sizeof(line), "Selected: %s ($%d)\nTarget: %s",
+                      getTowerName(selectedTower), selectedTowerCost, getTargetModeName(targetMode));
+        selectedTowerText->setString(line);
+    }
 }
 
-void UIManager::draw(sf::RenderWindow& window) const {
-    
-    auto& nonConstWindow = const_cast<sf::RenderWindow&>(window);
-    
+void UIManager::draw(sf::RenderWindow& window) {
+    if (staticLayerDirty && !staticLayerFailed) {
+        rebuildStaticLayer();
+    }
+
+    if (staticLayerSprite) {
+        window.draw(*staticLayerSprite, BLEND_PREMULTIPLIED);
+    } else {
+        drawStaticElements(window);
+    }
+
+    window.draw(*moneyText);
+    window.draw(*livesText);
+    window.draw(*waveText);
+    window.draw(*selectedTowerText);
+}
+
+void UIManager::drawStaticElements(sf::RenderTarget& target) const {
     // Draw UI panel background first
     if (uiPanelSprite) {
-        nonConstWindow.draw(*uiPanelSprite);
+        target.draw(*uiPanelSprite);
     } else {
-        nonConstWindow.draw(uiPanelBackground);
+        target.draw(uiPanelBackground);
     }
-    
-    nonConstWindow.draw(*moneyText);
-    nonConstWindow.draw(*livesText);
-    nonConstWindow.draw(*waveText);
-    nonConstWindow.draw(*selectedTowerText);
+    target.draw(*instructionsText);
+}
+
+void UIManager::rebuildStaticLayer() {
+    staticLayerDirty = false;
+
+    // Cover the panel plus its outline, in the same coordinates as the window
+    sf::FloatRect area = uiPanelBackground.getGlobalBounds();
+    sf::Vector2u size(static_cast<unsigned int>(std::ceil(area.size.x)),
+                      static_cast<unsigned int>(std::ceil(area.size.y)));
+    if (!staticLayer.resize(size)) {
+        std::cerr << "Render textures unavailable, drawing the UI panel directly" << std::endl;
+        staticLayerFailed = true;
+        staticLayerSprite.reset();
+        return;
+    }
+
+    staticLayer.setView(sf::View(area));
+    staticLayer.clear(sf::Color::Transparent);
+    drawStaticElements(staticLayer);
+    staticLayer.display();
+
+    staticLayerSprite.emplace(staticLayer.getTexture());
+    staticLayerSprite->setPosition(area.position);
 }
 
 void UIManager::drawTowerPreview(sf::RenderWindow& window, sf::Vector2i gridPos, bool canPlace) const {
@@ -96,7 +170,7 @@ void UIManager::drawTowerPreview(sf::RenderWindow& window, sf::Vector2i gridPos,
     
     // Create a temporary preview (we can't modify member in const function)
     sf::RectangleShape preview = towerPreview;
-    preview.setPosition({gridPos.x * 48.f + 1.f, gridPos.y * 48.f + 1.f});
+    preview.setPosition({gridPos.x * CELL_SIZE + 1.f, gridPos.y * CELL_SIZE + 1.f});
     
     // Green if can place, red if cannot
     if (canPlace) {
@@ -108,9 +182,16 @@ void UIManager::drawTowerPreview(sf::RenderWindow& window, sf::Vector2i gridPos,
     nonConstWindow.draw(preview);
 }
 
-void UIManager::drawInstructions(sf::RenderWindow& window) const {
-    auto& nonConstWindow = const_cast<sf::RenderWindow&>(window);
-    nonConstWindow.draw(*instructionsText);
+void UIManager::setProfilerReport(const std::string& report) {
+    profilerText->setString(report);
+
+    sf::FloatRect bounds = profilerText->getGlobalBounds();
+    profilerBackground.setSize({bounds.position.x + bounds.size.x + 8.f, bounds.position.y + bounds.size.y + 8.f});
+}
+
+void UIManager::drawProfilerOverlay(sf::RenderWindow& window) const {
+    window.draw(profilerBackground);
+    window.draw(*profilerText);
 }
 
 int UIManager::getTowerCost(TowerType type) const {
@@ -118,7 +199,7 @@ int UIManager::getTowerCost(TowerType type) const {
     return TOWER_COSTS[static_cast<int>(type)];
 }
 
-std::string UIManager::getTowerName(TowerType type) const {
+const char* UIManager::getTowerName(TowerType type) const {
     switch (type) {
         case TowerType::Barrier:   return "Barrier";
         case TowerType::Gatling:   return "Gatling";
@@ -1,6 +1,7 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <optional>
+#include <atomic>
 #include "tower.hpp"
 
 class UIManager {
@@ -11,6 +12,8 @@ private:
     std::optional<sf::Text> waveText;
     std::optional<sf::Text> selectedTowerText;
     std::optional<sf::Text> instructionsText;
+    std::optional<sf::Text> profilerText;
+    sf::RectangleShape profilerBackground;
     
     // Tower preview
     sf::RectangleShape towerPreview;
@@ -18,21 +21,44 @@ private:
     std::optional<sf::Sprite> uiPanelSprite;
     sf::RectangleShape uiPanelBackground; 
 
+    // Panel and instructions never change between frames, so they are drawn
+    // once into an off-screen texture and composited with a single sprite
+    sf::RenderTexture staticLayer;
+    std::optional<sf::Sprite> staticLayerSprite;
+    std::atomic<bool> staticLayerDirty{true};  // Set from the event thread, read by the drawing one
+    bool staticLayerFailed = false;  // No render-texture support: draw directly
+
+    void drawStaticElements(sf::RenderTarget& target) const;
+    void rebuildStaticLayer();
+
+    // Values the text currently shows; -1 forces the first update
+    int shownMoney = -1;
+    int shownLives = -1;
+    int shownWave = -1;
+    TowerType shownTower = TowerType::Barrier;
+    int shownTowerCost = -1;
+    TargetMode shownTargetMode = TargetMode::Closest;
+
     // Tower cost lookup
     int getTowerCost(TowerType type) const;
-    std::string getTowerName(TowerType type) const;
+    const char* getTowerName(TowerType type) const;
 
 public:
     UIManager(sf::Font& font);
 
-    // Update UI with current game state
-    void update(int money, int lives, int wave, TowerType selectedTower, int selectedTowerCost);
+    // Update UI with current game state. Cheap when nothing changed; call
+    // from the thread that draws.
+    void update(int money, int lives, int wave, TowerType selectedTower, int selectedTowerCost, TargetMode targetMode);
     
     // Draw UI elements
     void setUIPanelTexture(sf::Texture& texture);
 
-    void draw(sf::RenderWindow& window) const;
+    void draw(sf::RenderWindow& window);  // Panel, instructions and live text
     void drawTowerPreview(sf::RenderWindow& window, sf::Vector2i gridPos, bool canPlace) const;
-    void drawInstructions(sf::RenderWindow& window) const;
+    void invalidateStaticLayer() { staticLayerDirty = true; }  // After a resize or context loss
+
+    // Timing overlay drawn over the top-left of the map
+    void setProfilerReport(const std::string& report);
+    void drawProfilerOverlay(sf::RenderWindow& window) const;
     
 };
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include "benchmark.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace bench {
+
+namespace {
+    struct Registration {
+        std::string name;
+        BenchmarkFunction function;
+    };
+
+    std::vector<Registration>& registry() {
+        static std::vector<Registration> benchmarks;
+        return benchmarks;
+    }
+
+    struct Result {
+        std::string name;
+        std::size_t iterations;
+        double realTimeNs;  // Per iteration
+        double cpuTimeNs;
+        double itemsPerSecond;
+        std::map<std::string, double> counters;
+        std::string error;  // Set by State::skipWithError
+    };
+
+    constexpr double MIN_TIME = 0.2;  // Seconds each benchmark should run for
+
+    Result runOne(const Registration& benchmark) {
+        // Grow the iteration count until a run is long enough to trust
+        std::size_t iterations = 1;
+        while (true) {
+            State state(iterations);
+            benchmark.function(state);
+            double elapsed = state.elapsedSeconds();
+
+            if (!state.error().empty() || elapsed >= MIN_TIME || iterations >= 1000000000) {
+                Result result;
+                result.name = benchmark.name;
+                result.iterations = iterations;
+                result.realTimeNs = elapsed * 1e9 / iterations;
+                result.cpuTimeNs = state.elapsedCpuSeconds() * 1e9 / iterations;
+                result.itemsPerSecond = elapsed > 0 ? state.itemsProcessed / elapsed : 0.0;
+                for (const auto& [key, value] : state.counters) {
+                    result.counters[key] = value / iterations;
+                }
+                result.error = state.error();
+                return result;
+            }
+
+            double scale = elapsed > 0 ? MIN_TIME * 1.4 / elapsed : 10.0;
+            scale = std::min(std::max(scale, 2.0), 10.0);
+            iterations = static_cast<std::size_t>(iterations * scale);
+        }
+    }
+
+    void writeJson(std::ostream& out, const std::vector<Result>& results) {
+        out << "{\n  \"context\": {\n"
+            << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+            << "    \"library_build_type\": \"release\"\n"
+            << "  },\n  \"benchmarks\": [\n";
+        for (std::size_t i = 0; i < results.size(); i++) {
+            const Result& r = results[i];
+            out << "    {\n"
+                << "      \"name\": \"" << r.name << "\",\n"
+                << "      \"run_type\": \"iteration\",\n"
+                << "      \"iterations\": " << r.iterations << ",\n"
+                << "      \"real_time\": " << r.realTimeNs << ",\n"
+                << "      \"cpu_time\": " << r.cpuTimeNs << ",\n"
+                << "      \"time_unit\": \"ns\"";
+            if (!r.error.empty()) {
+                out << ",\n      \"error_occurred\": true,\n      \"error_message\": \"" << r.error << "\"";
+            }
+            if (r.itemsPerSecond > 0) {
+                out << ",\n      \"items_per_second\": " << r.itemsPerSecond;
+            }
+            for (const auto& [key, value] : r.counters) {
+                out << ",\n      \"" << key << "\": " << value;
+            }
+            out << "\n    }" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+    }
+}
+
+int registerBenchmark(const std::string& name, BenchmarkFunction function) {
+    registry().push_back({name, std::move(function)});
+    return static_cast<int>(registry().size());
+}
+
+int runBenchmarks(int argc, char* argv[]) {
+    std::string filter;
+    std::string outPath;
+    bool jsonToStdout = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("--benchmark_filter=", 0) == 0) {
+            filter = arg.substr(19);
+        } else if (arg.rfind("--benchmark_out=", 0) == 0) {
+            outPath = arg.substr(16);
+        } else if (arg == "--benchmark_format=json") {
+            jsonToStdout = true;
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<Result> results;
+    bool failed = false;
+    if (!jsonToStdout) {
+        std::printf("%-48s %14s %14s %12s\n", "Benchmark", "Time (ns)", "CPU (ns)", "Iterations");
+    }
+    for (const Registration& benchmark : registry()) {
+        if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) continue;
+
+        Result result = runOne(benchmark);
+        if (!result.error.empty()) {
+            std::fprintf(stderr, "%s: ERROR: %s\n", result.name.c_str(), result.error.c_str());
+            failed = true;
+        }
+        if (!jsonToStdout) {
+            std::printf("%-48s %14.0f %14.0f %12zu", result.name.c_str(),
+                        result.realTimeNs, result.cpuTimeNs, result.iterations);
+            for (const auto& [key, value] : result.counters) {
+                std::printf(" %s=%.1f", key.c_str(), value);
+            }
+            std::printf("\n");
+            std::fflush(stdout);
+        }
+        results.push_back(result);
+    }
+
+    if (jsonToStdout) {
+        writeJson(std::cout, results);
+    }
+    if (!outPath.empty()) {
+        std::ofstream file(outPath);
+        if (!file) {
+            std::cerr << "Failed to write " << outPath << std::endl;
+            return 1;
+        }
+        writeJson(file, results);
+    }
+    return failed ? 1 : 0;
+}
+
+}  // namespace bench
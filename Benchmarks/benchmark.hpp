@@ -0,0 +1,93 @@
+#pragma once
+// Minimal Google-Benchmark style harness. Supports the subset we need
+// (registration, timing pauses, counters, filtering, failing checks) and writes the same
+// JSON layout as --benchmark_format=json so results can be diffed with the
+// usual tooling.
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+class State {
+private:
+    std::size_t maxIterations;
+    std::size_t iteration = 0;
+    std::chrono::steady_clock::time_point start;
+    std::clock_t cpuStart = 0;
+    std::chrono::steady_clock::time_point end;  // Set when the loop finishes, so fixture teardown isn't timed
+    std::clock_t cpuEnd = 0;
+    bool finished = false;
+    std::string errorMessage;
+    double pausedSeconds = 0.0;
+    double pausedCpuSeconds = 0.0;
+    std::chrono::steady_clock::time_point pauseStart;
+    std::clock_t cpuPauseStart = 0;
+
+public:
+    std::map<std::string, double> counters;  // Reported per iteration average
+    std::int64_t itemsProcessed = 0;
+
+    explicit State(std::size_t iterations) : maxIterations(iterations) {}
+
+    // for (auto _ : state) style is replaced by while (state.keepRunning())
+    bool keepRunning() {
+        if (iteration == 0) {
+            start = std::chrono::steady_clock::now();
+            cpuStart = std::clock();
+        }
+        if (errorMessage.empty() && iteration++ < maxIterations) return true;
+
+        if (!finished) {
+            end = std::chrono::steady_clock::now();
+            cpuEnd = std::clock();
+            finished = true;
+        }
+        return false;
+    }
+
+    void pauseTiming() {
+        pauseStart = std::chrono::steady_clock::now();
+        cpuPauseStart = std::clock();
+    }
+
+    void resumeTiming() {
+        pausedSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - pauseStart).count();
+        pausedCpuSeconds += static_cast<double>(std::clock() - cpuPauseStart) / CLOCKS_PER_SEC;
+    }
+
+    void setItemsProcessed(std::int64_t items) { itemsProcessed = items; }
+
+    // Fail the benchmark: the loop stops and the run exits non-zero. The
+    // first message is kept
+    void skipWithError(const std::string& message) {
+        if (errorMessage.empty()) errorMessage = message;
+    }
+    const std::string& error() const { return errorMessage; }
+
+    std::size_t iterations() const { return maxIterations; }
+    // Up to the end of the loop; before that, up to now
+    double elapsedSeconds() const {
+        auto stop = finished ? end : std::chrono::steady_clock::now();
+        return std::chrono::duration<double>(stop - start).count() - pausedSeconds;
+    }
+    double elapsedCpuSeconds() const {
+        std::clock_t stop = finished ? cpuEnd : std::clock();
+        return static_cast<double>(stop - cpuStart) / CLOCKS_PER_SEC - pausedCpuSeconds;
+    }
+};
+
+using BenchmarkFunction = std::function<void(State&)>;
+
+// Register a benchmark; returns a value so it can initialise a static
+int registerBenchmark(const std::string& name, BenchmarkFunction function);
+
+// Run everything matching --benchmark_filter and report to stdout and,
+// with --benchmark_out=<file>, to a JSON file
+int runBenchmarks(int argc, char* argv[]);
+
+}  // namespace bench
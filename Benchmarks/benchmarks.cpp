@@ -0,0 +1,587 @@
+// Microbenchmarks for the simulation hot paths.
+// Run with --benchmark_out=results.json to keep a JSON record per release.
+#include "benchmark.hpp"
+#include "grid.hpp"
+#include "a_star_path_finder.hpp"
+#include "hierarchical_pathfinder.hpp"
+#include "frame_arena.hpp"
+#include "min_heap.hpp"
+#include "enemy_manager.hpp"
+#include "projectile_manager.hpp"
+#include "enemy.hpp"
+#include "target_index.hpp"
+#include "grid_units.hpp"
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+enum class Layout {
+    Open,      // No obstacles
+    Scattered, // Open field with one cell in ten blocked at random, like loosely placed towers
+    Maze,      // Serpentine walls, path visits most of the map
+    Spiral     // Concentric rings, goal in the middle
+};
+
+const char* layoutName(Layout layout) {
+    switch (layout) {
+        case Layout::Open:      return "open";
+        case Layout::Scattered: return "scattered";
+        case Layout::Maze:      return "maze";
+        case Layout::Spiral:    return "spiral";
+    }
+    return "unknown";
+}
+
+// Build a square grid with the given layout and set its start/end cells
+std::unique_ptr<Grid> makeGrid(Layout layout, int size) {
+    auto grid = std::make_unique<Grid>(size, size);
+
+    switch (layout) {
+        case Layout::Open:
+            grid->setStartEnd({0, size / 2}, {size - 1, size / 2});
+            break;
+
+        case Layout::Scattered: {
+            std::mt19937 rng(11);
+            std::uniform_int_distribution<int> cell(0, size - 1);
+            for (int i = 0; i < size * size / 10; i++) {
+                grid->setObstacle(cell(rng), cell(rng), true);
+            }
+            grid->setStartEnd({0, size / 2}, {size - 1, size / 2});
+            grid->setObstacle(0, size / 2, false);
+            grid->setObstacle(size - 1, size / 2, false);
+            break;
+        }
+
+        case Layout::Maze:
+            // Wall every other column, with the gap alternating top/bottom
+            for (int x = 1; x < size - 1; x += 2) {
+                int gapY = ((x / 2) % 2 == 0) ? size - 1 : 0;
+                for (int y = 0; y < size; y++) {
+                    if (y != gapY) grid->setObstacle(x, y, true);
+                }
+            }
+            grid->setStartEnd({0, 0}, {size - 1, size - 1});
+            break;
+
+        case Layout::Spiral:
+            // Square rings two cells apart, each with one gap on alternating sides
+            for (int ring = 1; ring * 2 < size / 2; ring++) {
+                int lo = ring * 2 - 1;
+                int hi = size - ring * 2;
+                for (int i = lo; i <= hi; i++) {
+                    grid->setObstacle(i, lo, true);
+                    grid->setObstacle(i, hi, true);
+                    grid->setObstacle(lo, i, true);
+                    grid->setObstacle(hi, i, true);
+                }
+                int mid = (lo + hi) / 2;
+                if (ring % 2 == 0) {
+                    grid->setObstacle(lo, mid, false);
+                } else {
+                    grid->setObstacle(hi, mid, false);
+                }
+            }
+            grid->setStartEnd({0, 0}, {size / 2, size / 2});
+            break;
+    }
+    return grid;
+}
+
+void registerFindPath() {
+    for (Layout layout : {Layout::Open, Layout::Maze, Layout::Spiral}) {
+        for (int size : {20, 64, 128, 256}) {
+            std::string name = std::string("BM_FindPath/") + layoutName(layout) + "/" + std::to_string(size);
+            bench::registerBenchmark(name, [layout, size](bench::State& state) {
+                auto grid = makeGrid(layout, size);
+                AStarPathfinder pathfinder(grid.get());
+                pathfinder.setPathCacheEnabled(false);  // Measure the search, not the lookup
+                Node* start = grid->getNode(grid->getStart().x, grid->getStart().y);
+                Node* end = grid->getNode(grid->getEnd().x, grid->getEnd().y);
+
+                std::size_t pathLength = 0;
+                while (state.keepRunning()) {
+                    pathLength += pathfinder.findPath(start, end).size();
+                }
+                state.counters["path_length"] = static_cast<double>(pathLength);
+            });
+        }
+    }
+}
+
+// Plain A* against jump point search on the same maps; "expanded" is nodes
+// taken off the open set per search
+void registerSearchModes() {
+    const std::pair<AStarPathfinder::SearchMode, const char*> modes[] = {
+        {AStarPathfinder::SearchMode::AStar, "astar"},
+        {AStarPathfinder::SearchMode::JumpPoint, "jps"}
+    };
+    for (const auto& [mode, modeName] : modes) {
+        for (Layout layout : {Layout::Open, Layout::Scattered, Layout::Maze}) {
+            std::string name = std::string("BM_SearchMode/") + modeName + "/" + layoutName(layout) + "/200";
+            bench::registerBenchmark(name, [mode, layout](bench::State& state) {
+                auto grid = makeGrid(layout, 200);
+                AStarPathfinder pathfinder(grid.get(), mode);
+                pathfinder.setPathCacheEnabled(false);
+                Node* start = grid->getNode(grid->getStart().x, grid->getStart().y);
+                Node* end = grid->getNode(grid->getEnd().x, grid->getEnd().y);
+
+                std::size_t expanded = 0, pathLength = 0;
+                while (state.keepRunning()) {
+                    pathLength += pathfinder.findPath(start, end).size();
+                    expanded += pathfinder.getExpandedNodes();
+                }
+                state.counters["expanded"] = static_cast<double>(expanded);
+                state.counters["path_length"] = static_cast<double>(pathLength);
+            });
+        }
+    }
+}
+
+void registerHierarchical() {
+    for (Layout layout : {Layout::Open, Layout::Maze}) {
+        for (int size : {256, 1024}) {
+            std::string name = std::string("BM_HierarchicalRoute/") + layoutName(layout) + "/" + std::to_string(size);
+            bench::registerBenchmark(name, [layout, size](bench::State& state) {
+                auto grid = makeGrid(layout, size);
+                HierarchicalPathfinder hierarchy(grid.get());
+                hierarchy.update();
+                Node* start = grid->getNode(grid->getStart().x, grid->getStart().y);
+                Node* end = grid->getNode(grid->getEnd().x, grid->getEnd().y);
+
+                std::vector<Node*> waypoints;
+                std::size_t waypointCount = 0;
+                while (state.keepRunning()) {
+                    hierarchy.findRoute(start, end, waypoints);
+                    waypointCount += waypoints.size();
+                    FrameArena::resetAll();
+                }
+                state.counters["waypoints"] = static_cast<double>(waypointCount);
+            });
+        }
+    }
+
+    // A placement: block a cell, bring the abstraction up to date and replan
+    for (int size : {256, 1024}) {
+        bench::registerBenchmark("BM_HierarchicalReplan/" + std::to_string(size), [size](bench::State& state) {
+            auto grid = makeGrid(Layout::Open, size);
+            HierarchicalPathfinder hierarchy(grid.get());
+            hierarchy.update();
+            Node* start = grid->getNode(grid->getStart().x, grid->getStart().y);
+            Node* end = grid->getNode(grid->getEnd().x, grid->getEnd().y);
+            std::mt19937 rng(5);
+            std::uniform_int_distribution<int> cell(1, size - 2);
+
+            std::vector<Node*> waypoints;
+            while (state.keepRunning()) {
+                int x = cell(rng), y = cell(rng);
+                grid->setObstacle(x, y, grid->isWalkable(x, y));  // Toggle
+                hierarchy.update();
+                hierarchy.findRoute(start, end, waypoints);
+                FrameArena::resetAll();
+            }
+        });
+    }
+}
+
+// MinHeap against BucketQueue as the open list. BM_OpenList searches goal to
+// start, so A* runs on the Manhattan heuristic rather than the goal
+// distance table; BM_GoalDistances rebuilds that table (one Dijkstra over
+// the whole map) after a one-cell change
+void registerOpenLists() {
+    const std::pair<AStarPathfinder::OpenList, const char*> lists[] = {
+        {AStarPathfinder::OpenList::BinaryHeap, "heap"},
+        {AStarPathfinder::OpenList::Buckets, "buckets"}
+    };
+    for (const auto& [list, listName] : lists) {
+        for (Layout layout : {Layout::Open, Layout::Scattered, Layout::Maze}) {
+            std::string name = std::string("BM_OpenList/") + listName + "/" + layoutName(layout) + "/200";
+            bench::registerBenchmark(name, [list, layout](bench::State& state) {
+                auto grid = makeGrid(layout, 200);
+                AStarPathfinder pathfinder(grid.get(), AStarPathfinder::SearchMode::AStar, list);
+                pathfinder.setPathCacheEnabled(false);
+                Node* start = grid->getNode(grid->getEnd().x, grid->getEnd().y);
+                Node* end = grid->getNode(grid->getStart().x, grid->getStart().y);
+
+                std::size_t expanded = 0;
+                while (state.keepRunning()) {
+                    pathfinder.findPath(start, end);
+                    expanded += pathfinder.getExpandedNodes();
+                }
+                state.counters["expanded"] = static_cast<double>(expanded);
+            });
+        }
+
+        for (Layout layout : {Layout::Open, Layout::Maze}) {
+            std::string name = std::string("BM_GoalDistances/") + listName + "/" + layoutName(layout) + "/256";
+            bench::registerBenchmark(name, [list, layout](bench::State& state) {
+                auto grid = makeGrid(layout, 256);
+                AStarPathfinder pathfinder(grid.get(), AStarPathfinder::SearchMode::AStar, list);
+                while (state.keepRunning()) {
+                    grid->setObstacle(255, 0, grid->isWalkable(255, 0));  // Toggle a corner
+                    pathfinder.getGoalDistance(0, 0);
+                    FrameArena::resetAll();
+                }
+            });
+        }
+    }
+}
+
+// Cost of the cheapest path by plain Dijkstra over the grid, INFINITY if none
+float referenceCost(Grid& grid, Node* start, Node* end) {
+    int width = grid.getWidth();
+    std::vector<float> cost(static_cast<std::size_t>(width) * grid.getHeight(), INFINITY);
+    using Entry = std::pair<float, Node*>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    cost[start->y * width + start->x] = 0.f;
+    open.push({0.f, start});
+
+    std::pmr::vector<Node*> neighbors;
+    while (!open.empty()) {
+        auto [g, node] = open.top();
+        open.pop();
+        if (node == end) return g;
+        if (g > cost[node->y * width + node->x]) continue;
+
+        grid.getNeighbors(node, neighbors);
+        for (Node* next : neighbors) {
+            if (!next->walkable) continue;
+            float nextCost = g + next->getMovementCost();
+            if (nextCost < cost[next->y * width + next->x]) {
+                cost[next->y * width + next->x] = nextCost;
+                open.push({nextCost, next});
+            }
+        }
+    }
+    return INFINITY;
+}
+
+// Cost of `path` from `start` to `end`, or NAN if it isn't a walkable chain
+// of neighbouring cells between them
+float pathCost(const std::vector<Node*>& path, Node* start, Node* end) {
+    if (path.empty() || path.front() != start || path.back() != end) return NAN;
+    float cost = 0.f;
+    for (std::size_t i = 1; i < path.size(); i++) {
+        if (!path[i]->walkable || std::abs(path[i]->x - path[i - 1]->x) + std::abs(path[i]->y - path[i - 1]->y) != 1) {
+            return NAN;
+        }
+        cost += path[i]->getMovementCost();
+    }
+    return cost;
+}
+
+// Not a timing: every search configuration must find paths as cheap as a
+// reference Dijkstra on random grids with walls and frost, before and after
+// the grid changes under them. Fails the run on the first mismatch.
+void registerSearchConsistency() {
+    bench::registerBenchmark("BM_SearchConsistency/48", [](bench::State& state) {
+        constexpr int SIZE = 48;
+        std::mt19937 rng(17);
+        std::uniform_int_distribution<int> cell(0, SIZE - 1);
+        std::uniform_int_distribution<int> percent(0, 99);
+        std::size_t queries = 0;
+
+        while (state.keepRunning()) {
+            Grid grid(SIZE, SIZE);
+            int wallPercent = 10 + percent(rng) % 25;
+            for (int y = 0; y < SIZE; y++) {
+                for (int x = 0; x < SIZE; x++) {
+                    if (percent(rng) < wallPercent) grid.setObstacle(x, y, true);
+                }
+            }
+            for (int i = 0; i < 6; i++) grid.applyFrostEffect(cell(rng), cell(rng), 2, 0.5f);
+            grid.setStartEnd({0, 0}, {SIZE - 1, SIZE - 1});
+            grid.setObstacle(SIZE - 1, SIZE - 1, false);
+
+            const std::pair<const char*, std::unique_ptr<AStarPathfinder>> searches[] = {
+                {"astar", std::make_unique<AStarPathfinder>(&grid)},
+                {"jps", std::make_unique<AStarPathfinder>(&grid, AStarPathfinder::SearchMode::JumpPoint)},
+                {"buckets", std::make_unique<AStarPathfinder>(&grid, AStarPathfinder::SearchMode::AStar,
+                                                              AStarPathfinder::OpenList::Buckets)},
+                {"cached", std::make_unique<AStarPathfinder>(&grid)}
+            };
+            for (std::size_t i = 0; i + 1 < std::size(searches); i++) searches[i].second->setPathCacheEnabled(false);
+
+            // The same queries every round. Rounds after the first change the
+            // grid, so incremental tables and cache entries are reused
+            std::vector<std::pair<sf::Vector2i, sf::Vector2i>> pairs;
+            for (int q = 0; q < 16; q++) {
+                sf::Vector2i end = (q % 2 == 0) ? sf::Vector2i(SIZE - 1, SIZE - 1) : sf::Vector2i(cell(rng), cell(rng));
+                pairs.push_back({{cell(rng), cell(rng)}, end});
+            }
+
+            for (int round = 0; round < 6 && state.error().empty(); round++) {
+                if (round > 0) {
+                    for (int i = 0; i < 8; i++) {
+                        int x = cell(rng), y = cell(rng);
+                        grid.setObstacle(x, y, grid.isWalkable(x, y));
+                    }
+                    int fx = cell(rng), fy = cell(rng);
+                    if (round % 2 == 1) grid.applyFrostEffect(fx, fy, 2, 0.5f);
+                    else grid.removeFrostEffect(fx, fy, 2, 0.5f);
+                    grid.setObstacle(SIZE - 1, SIZE - 1, false);
+                }
+
+                for (const auto& [from, to] : pairs) {
+                    if (!state.error().empty()) break;
+                    Node* start = grid.getNode(from.x, from.y);
+                    Node* end = grid.getNode(to.x, to.y);
+                    if (!start->walkable || !end->walkable) continue;
+
+                    float expected = referenceCost(grid, start, end);
+                    for (const auto& [searchName, pathfinder] : searches) {
+                        std::vector<Node*> path = pathfinder->findPath(start, end);
+                        float cost = path.empty() ? INFINITY : pathCost(path, start, end);
+                        bool match = (expected == INFINITY) ? cost == INFINITY : std::abs(cost - expected) < 1e-3f;
+                        if (!match) {
+                            char message[160];
+                            std::snprintf(message, sizeof(message), "%s: (%d,%d) to (%d,%d) cost %.2f, expected %.2f",
+                                          searchName, start->x, start->y, end->x, end->y, cost, expected);
+                            state.skipWithError(message);
+                            break;
+                        }
+                    }
+                    queries++;
+                    FrameArena::resetAll();
+                }
+            }
+        }
+        state.counters["queries"] = static_cast<double>(queries);
+    });
+}
+
+void registerMinHeap() {
+    for (int count : {1000, 10000, 100000}) {
+        bench::registerBenchmark("BM_MinHeapPushPop/" + std::to_string(count), [count](bench::State& state) {
+            std::mt19937 rng(42);
+            std::uniform_real_distribution<float> cost(0.f, 1000.f);
+            std::vector<Node> nodes(count);
+            for (Node& node : nodes) {
+                node.gCost = cost(rng);
+                node.hCost = cost(rng);
+            }
+
+            MinHeap heap;
+            while (state.keepRunning()) {
+                for (Node& node : nodes) heap.push(&node);
+                while (!heap.empty()) heap.pop();
+            }
+            state.setItemsProcessed(static_cast<std::int64_t>(state.iterations()) * count);
+        });
+    }
+}
+
+void registerRecalculatePaths() {
+    for (int enemyCount : {10, 100, 500}) {
+        for (int size : {20, 64}) {
+            std::string name = "BM_RecalculatePaths/" + std::to_string(size) + "/" + std::to_string(enemyCount);
+            bench::registerBenchmark(name, [enemyCount, size](bench::State& state) {
+                auto grid = makeGrid(Layout::Maze, size);
+                AStarPathfinder pathfinder(grid.get());
+                EnemyManager enemyManager(grid.get(), &pathfinder);
+
+                // Spread the enemies out along the path before measuring
+                enemyManager.spawnWave(enemyCount, 0.05f);
+                for (int tick = 0; tick < enemyCount * 3 + 1; tick++) {
+                    enemyManager.update(1.0f / 60.0f);
+                }
+
+                pathfinder.setPathCacheEnabled(false);
+                while (state.keepRunning()) {
+                    enemyManager.recalculatePaths();
+                }
+            });
+        }
+    }
+
+    // A placement followed by a repath of every enemy, with and without the
+    // path cache. Each iteration toggles a different cell, so the grid is
+    // (almost always) in a state the cache hasn't seen
+    for (bool cached : {false, true}) {
+        std::string name = std::string("BM_RepathBurst/") + (cached ? "cache" : "nocache") + "/64/500";
+        bench::registerBenchmark(name, [cached](bench::State& state) {
+            auto grid = makeGrid(Layout::Open, 64);
+            AStarPathfinder pathfinder(grid.get());
+            pathfinder.setPathCacheEnabled(cached);
+            EnemyManager enemyManager(grid.get(), &pathfinder);
+
+            enemyManager.spawnWave(500, 0.05f);
+            for (int tick = 0; tick < 500 * 3 + 1; tick++) {
+                enemyManager.update(1.0f / 60.0f);
+            }
+
+            std::mt19937 rng(9);
+            std::uniform_int_distribution<int> cell(1, 62);
+            while (state.keepRunning()) {
+                int x = cell(rng), y = cell(rng);
+                grid->setObstacle(x, y, grid->isWalkable(x, y));  // Toggle
+                enemyManager.recalculatePaths();
+            }
+            state.counters["cache_hits"] = static_cast<double>(pathfinder.getPathCache().getHits());
+            state.counters["cache_misses"] = static_cast<double>(pathfinder.getPathCache().getMisses());
+        });
+    }
+}
+
+void registerProjectileUpdate() {
+    for (int projectileCount : {100, 1000}) {
+        for (int enemyCount : {50, 500}) {
+            std::string name = "BM_ProjectileUpdate/" + std::to_string(projectileCount) + "/" + std::to_string(enemyCount);
+            bench::registerBenchmark(name, [projectileCount, enemyCount](bench::State& state) {
+                std::mt19937 rng(7);
+                std::uniform_real_distribution<float> coord(0.f, 960.f);
+                std::uniform_real_distribution<float> angle(0.f, 6.2831853f);
+                std::uniform_int_distribution<int> cellX(0, 19);
+                std::uniform_int_distribution<int> cellY(0, 14);
+
+                // Stationary, effectively unkillable targets so every iteration sees the same load
+                Grid grid(20, 15);
+                std::vector<std::unique_ptr<Enemy>> enemies;
+                for (int i = 0; i < enemyCount; i++) {
+                    std::vector<Node*> path = { grid.getNode(cellX(rng), cellY(rng)) };
+                    auto enemy = std::make_unique<Enemy>(path, 0.f, 1 << 30);
+                    enemy->setId(i);
+                    enemies.push_back(std::move(enemy));
+                }
+
+                std::unique_ptr<ProjectileManager> projectiles;
+                while (state.keepRunning()) {
+                    state.pauseTiming();
+                    projectiles = std::make_unique<ProjectileManager>();  // Last iteration's is freed untimed
+                    for (int i = 0; i < projectileCount; i++) {
+                        float a = angle(rng);
+                        projectiles->spawnProjectile({coord(rng), coord(rng) * 0.75f},
+                                                     {std::cos(a), std::sin(a)}, 400.f, 15);
+                    }
+                    state.resumeTiming();
+
+                    projectiles->update(1.0f / 60.0f, enemies);
+                }
+                state.setItemsProcessed(static_cast<std::int64_t>(state.iterations()) * projectileCount);
+            });
+        }
+    }
+}
+
+// One tick of movement for many enemies spread along a long maze path
+void registerEnemyUpdate() {
+    for (int enemyCount : {100, 1000}) {
+        bench::registerBenchmark("BM_EnemyUpdate/" + std::to_string(enemyCount), [enemyCount](bench::State& state) {
+            auto grid = makeGrid(Layout::Maze, 128);
+            AStarPathfinder pathfinder(grid.get());
+            std::vector<Node*> path = pathfinder.findPath(grid->getNode(grid->getStart().x, grid->getStart().y),
+                                                          grid->getNode(grid->getEnd().x, grid->getEnd().y));
+
+            std::vector<std::unique_ptr<Enemy>> enemies;
+            for (int i = 0; i < enemyCount; i++) {
+                std::size_t offset = path.size() / 2 * i / enemyCount;
+                enemies.push_back(std::make_unique<NormalEnemy>(
+                    std::vector<Node*>(path.begin() + static_cast<std::ptrdiff_t>(offset), path.end())));
+            }
+
+            while (state.keepRunning()) {
+                for (auto& enemy : enemies) enemy->update(1.0f / 60.0f);
+            }
+            state.setItemsProcessed(static_cast<std::int64_t>(state.iterations()) * enemyCount);
+        });
+    }
+}
+
+// One tick of "first enemy in range" for a field of towers: a scan of every
+// enemy per tower against one index rebuild shared by all of them
+void registerTargeting() {
+    constexpr int TOWERS = 64;
+    constexpr float RANGE = 150.f;
+    for (int enemyCount : {100, 1000}) {
+        for (bool indexed : {false, true}) {
+            std::string name = "BM_Targeting/" + std::to_string(enemyCount) + (indexed ? "/index" : "/scan");
+            bench::registerBenchmark(name, [enemyCount, indexed](bench::State& state) {
+                auto grid = makeGrid(Layout::Maze, 128);
+                AStarPathfinder pathfinder(grid.get());
+                std::vector<Node*> path = pathfinder.findPath(grid->getNode(grid->getStart().x, grid->getStart().y),
+                                                              grid->getNode(grid->getEnd().x, grid->getEnd().y));
+
+                std::vector<std::unique_ptr<Enemy>> enemies;
+                for (int i = 0; i < enemyCount; i++) {
+                    std::size_t offset = path.size() * i / enemyCount;
+                    auto enemy = std::make_unique<NormalEnemy>(
+                        std::vector<Node*>(path.begin() + static_cast<std::ptrdiff_t>(offset), path.end()));
+                    enemy->setId(i);
+                    enemies.push_back(std::move(enemy));
+                }
+
+                // Towers beside the path, spread along its length
+                std::vector<sf::Vector2f> towers;
+                for (int i = 0; i < TOWERS; i++) {
+                    const Node* node = path[path.size() * i / TOWERS];
+                    towers.push_back(cellToWorld(node->x, node->y));
+                }
+
+                TargetIndex index;
+                long long found = 0;
+                while (state.keepRunning()) {
+                    if (indexed) {
+                        index.rebuild(enemies, grid->getWidth(), grid->getHeight());
+                        for (sf::Vector2f tower : towers) {
+                            if (index.find(tower, RANGE, TargetMode::First)) found++;
+                        }
+                    } else {
+                        for (sf::Vector2f tower : towers) {
+                            Enemy* best = nullptr;
+                            for (const auto& enemy : enemies) {
+                                sf::Vector2f d = enemy->getPosition() - tower;
+                                if (d.x * d.x + d.y * d.y > RANGE * RANGE) continue;
+                                if (!best || enemy->getRemainingDistance() < best->getRemainingDistance()) best = enemy.get();
+                            }
+                            if (best) found++;
+                        }
+                    }
+                }
+                state.counters["targets"] = static_cast<double>(found);
+                state.setItemsProcessed(static_cast<std::int64_t>(state.iterations()) * TOWERS);
+            });
+        }
+    }
+}
+
+void registerFrost() {
+    for (int size : {64, 256}) {
+        bench::registerBenchmark("BM_ApplyFrostEffect/" + std::to_string(size), [size](bench::State& state) {
+            Grid grid(size, size);
+            std::mt19937 rng(3);
+            std::uniform_int_distribution<int> cell(0, size - 1);
+
+            while (state.keepRunning()) {
+                int x = cell(rng);
+                int y = cell(rng);
+                grid.applyFrostEffect(x, y, 2, 0.5f);
+                grid.removeFrostEffect(x, y, 2, 0.5f);
+            }
+        });
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    registerFindPath();
+    registerSearchModes();
+    registerHierarchical();
+    registerOpenLists();
+    registerSearchConsistency();
+    registerMinHeap();
+    registerRecalculatePaths();
+    registerProjectileUpdate();
+    registerEnemyUpdate();
+    registerTargeting();
+    registerFrost();
+    return bench::runBenchmarks(argc, argv);
+}